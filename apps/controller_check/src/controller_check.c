@@ -26,15 +26,26 @@ void main(void)
 
   const char tag[] = "2024 Jay Convertino";
 
+  /* keypad names in key order, 0 to 9, star, pound */
+  const char keyNames[] = "0123456789*#";
+
+  char keyTxt[] = "     ";
+
   /* setup tms9928 chip and finish setting up struct */
   initTMS99XX(&tms99XX, TXT_MODE, TMS_BLACK);
 
   setTMS99XXtxtColor(&tms99XX, TMS_WHITE);
 
-  /* ascii chars */
-  setTMS99XXvramWriteAddr(&tms99XX, PATTERN_TABLE_ADDR);
+  /* clear only the vdp tables text mode uses */
+  initTMS99XXvram(&tms99XX);
 
-  setTMS99XXvramData(&tms99XX, c_tms99XX_ascii, sizeof(c_tms99XX_ascii));
+  /* ascii chars, patterns match character codes */
+  setTMS99XXfont(&tms99XX, &c_tms99XX_asciiFont, TMS99XX_ASCII_FIRST, TMS99XX_ASCII_NUMBER, TMS99XX_ASCII_FIRST, FONT_PLAIN);
+
+#if !TMS99XX_ASCII_LOWER
+  /* BIOS font is upper case only, fold lower case onto the upper case glyphs */
+  setTMS99XXfont(&tms99XX, &c_tms99XX_asciiFont, 'A', 26, 'a', FONT_PLAIN);
+#endif
 
   /* write title on line 0 */
   setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR);
@@ -49,85 +60,60 @@ void main(void)
   /* enable screen */
   setTMS99XXblank(&tms99XX, 0);
 
+  /* vdp irq paces the main loop */
+  setTMS99XXirq(&tms99XX, 1);
+
   for(;;)
   {
-    volatile uint16_t controller = getControllerOne();
+    struct s_input pad;
+
+    get_input(0, &pad);
 
     setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR + (CHAR_PER_LINE * BUTTON_LINE));
 
-    //keypad mask
     /* when fire is pressed, start selected game */
-    if(!((controller >> FIRE_BIT) & 0x0001))
+    if(pad.held & (1 << FIRE_BIT))
     {
       setTMS99XXvramData(&tms99XX, "FIRE  ", 6);
     }
-    else if(!((controller >> ARM_BIT) & 0x0001))
+    else if(pad.held & (1 << ARM_BIT))
     {
       setTMS99XXvramData(&tms99XX, "ARM   ", 6);
     }
-    else if(!((controller >> UP_BIT) & 0x0001))
+    else if(pad.held & (1 << UP_BIT))
     {
       setTMS99XXvramData(&tms99XX, "UP    ", 6);
     }
-    else if(!((controller >> LEFT_BIT) & 0x0001))
+    else if(pad.held & (1 << LEFT_BIT))
     {
       setTMS99XXvramData(&tms99XX, "LEFT  ", 6);
     }
-    else if(!((controller >> RIGHT_BIT) & 0x0001))
+    else if(pad.held & (1 << RIGHT_BIT))
     {
       setTMS99XXvramData(&tms99XX, "RIGHT ", 6);
     }
-    else if(!((controller >> DOWN_BIT) & 0x0001))
+    else if(pad.held & (1 << DOWN_BIT))
     {
       setTMS99XXvramData(&tms99XX, "DOWN  ", 6);
     }
-    else if(((controller >> KEYPAD_BIT) & 0x000F) != 0x000F)
+    else if(pad.key != KEY_NONE)
     {
-      switch((controller >> KEYPAD_BIT) & 0x000F)
-      {
-        case 10:
-          setTMS99XXvramData(&tms99XX, "0    ", 6);
-          break;
-        case 13:
-          setTMS99XXvramData(&tms99XX, "1    ", 6);
-          break;
-        case 7:
-          setTMS99XXvramData(&tms99XX, "2    ", 6);
-          break;
-        case 12:
-          setTMS99XXvramData(&tms99XX, "3    ", 6);
-          break;
-        case 2:
-          setTMS99XXvramData(&tms99XX, "4    ", 6);
-          break;
-        case 3:
-          setTMS99XXvramData(&tms99XX, "5    ", 6);
-          break;
-        case 14:
-          setTMS99XXvramData(&tms99XX, "6    ", 6);
-          break;
-        case 5:
-          setTMS99XXvramData(&tms99XX, "7    ", 6);
-          break;
-        case 1:
-          setTMS99XXvramData(&tms99XX, "8    ", 6);
-          break;
-        case 11:
-          setTMS99XXvramData(&tms99XX, "9    ", 6);
-          break;
-        case 9:
-          setTMS99XXvramData(&tms99XX, "*    ", 6);
-          break;
-        case 6:
-          setTMS99XXvramData(&tms99XX, "#    ", 6);
-          break;
-      }
+      /* key decoded by the arch table, index the name */
+      keyTxt[0] = keyNames[pad.key];
+
+      setTMS99XXvramData(&tms99XX, keyTxt, 6);
     }
     else
     {
-      setTMS99XXvramConstData(&tms99XX, 0, 40);
+      setTMS99XXvramConstData(&tms99XX, ' ', 40);
     }
-    __delay_us(750);
+
+#if STACK_CHECK
+    /* stack high water above the tag, build with -DSTACK_CHECK=1 */
+    setTMS99XXstackOverlay(&tms99XX, 0, LAST_LINE - 1);
+#endif
+
+    wait_vblank();
   }
 }
 
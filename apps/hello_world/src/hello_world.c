@@ -7,13 +7,7 @@
 #include <tms99XX.h>
 #include <tms99XXascii.h>
 
-#if defined(_COLECO_SGM) || defined(_MSX)
-#include <gisnd.h>
-#endif
-
-#ifndef _MSX
-#include <sn76489.h>
-#endif
+#include <sound.h>
 
 #if defined(_COLECO) || defined(_COLECO_SGM)
   __at 0x8024 const char game_info[] = "HELLO WORLD!\x1E\x1F/JAY CONVERTINO/2024";
@@ -34,35 +28,37 @@ void main(void)
 
   const char txtmode[] = "TXT";
 
-  /* create struct to store ascii name table in order, removing first 32 null patterns */
-  uint8_t nameTable[1 + (sizeof(c_tms99XX_ascii)/8) - 32] = {0};
+  /* frames from init to first displayed frame, digits filled in at runtime */
+  char bootTxt[] = "BOOT FRAMES 00000";
+
+  uint16_t bootFrames = 0;
+
+  /* create struct to store ascii name table in order */
+  uint8_t nameTable[TMS99XX_ASCII_NUMBER] = {0};
 
   /* create nametable to display all ascii characters */
   for(index = 0; index < sizeof(nameTable); index++)
   {
-    /** offset to skip first 32 nulls **/
-    nameTable[index] = (unsigned char)index + 32;
+    nameTable[index] = (unsigned char)index + TMS99XX_ASCII_FIRST;
   }
 
   /* setup tms9928 chip and finish setting up struct */
   initTMS99XX(&tms99XX, TXT_MODE, TMS_BLACK);
 
-  /* clear all ti vdp memory */
-  clearTMS99XXvramData(&tms99XX);
+  /* clear only the vdp tables text mode uses */
+  initTMS99XXvram(&tms99XX);
 
   setTMS99XXtxtColor(&tms99XX, TMS_WHITE);
 
   // setTMS99XXblank(&tms99XX, 1);
 
-  /* ascii chars */
-  setTMS99XXvramWriteAddr(&tms99XX, PATTERN_TABLE_ADDR);
+  /* ascii chars, patterns match character codes */
+  setTMS99XXfont(&tms99XX, &c_tms99XX_asciiFont, TMS99XX_ASCII_FIRST, TMS99XX_ASCII_NUMBER, TMS99XX_ASCII_FIRST, FONT_PLAIN);
 
-  setTMS99XXvramData(&tms99XX, c_tms99XX_ascii, sizeof(c_tms99XX_ascii));
-
-  /* first ascii letter is space in this table, no image */
-  setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR);
-
-  setTMS99XXvramConstData(&tms99XX, 0, 0x7FF);
+#if !TMS99XX_ASCII_LOWER
+  /* BIOS font is upper case only, fold lower case onto the upper case glyphs */
+  setTMS99XXfont(&tms99XX, &c_tms99XX_asciiFont, 'A', 26, 'a', FONT_PLAIN);
+#endif
 
   /* write all ascii text */
   setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR);
@@ -84,17 +80,28 @@ void main(void)
   /* enable screen */
   setTMS99XXblank(&tms99XX, 0);
 
-#if defined(_COLECO_SGM) || defined(_MSX)
-  setGISNDchannel_freq('A', 256);
+  /* write boot latency on line 21 */
+  bootFrames = getTMS99XXbootFrames(&tms99XX);
 
-  setGISNDmixer(~0, 0xFE);
+  for(index = sizeof(bootTxt) - 2; index >= (int)sizeof(bootTxt) - 6; index--)
+  {
+    bootTxt[index] = (char)('0' + (bootFrames % 10));
 
-  setGISNDchannel_attn('A', 15, 0);
-#else
-  setSN76489voice_attn(1, 2);
-  /* set frequency to 440 hz */
-  setSN76489voice_freq(1, 254);
-#endif
+    bootFrames /= 10;
+  }
+
+  setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR + (40 * 21));
+
+  setTMS99XXvramData(&tms99XX, bootTxt, sizeof(bootTxt) - 1);
+
+  initSound();
+
+  setSoundVolume(0, 13);
+  /* set frequency to 440 hz */
+  setSoundPitch(0, SND_PITCH(SND_NOTE(4, 9), 0));
+
+  /* vdp irq paces the main loop */
+  setTMS99XXirq(&tms99XX, 1);
 
   for(;;)
   {
@@ -111,7 +118,10 @@ void main(void)
 
     setTMS99XXvramData(&tms99XX, &scrollArray[0], 1);
 
-    __delay_us(32000);
+    /* scroll every other frame */
+    wait_vblank();
+
+    wait_vblank();
   }
 }
 
@@ -22,7 +22,7 @@ void main(void)
 
   volatile uint8_t buffer = (uint8_t)~0;
 
-  uint8_t counter = 0;
+  struct s_input pad;
 
   const uint8_t num_of_roms = sizeof(roms) / sizeof(roms[0]);
 
@@ -44,17 +44,23 @@ void main(void)
 
   setTMS99XXtxtColor(&tms99XX, TMS_WHITE);
 
-  /* ascii chars */
-  setTMS99XXvramWriteAddr(&tms99XX, PATTERN_TABLE_ADDR);
+  /* ascii chars, patterns match character codes */
+  setTMS99XXfont(&tms99XX, &c_tms99XX_asciiFont, TMS99XX_ASCII_FIRST, TMS99XX_ASCII_NUMBER, TMS99XX_ASCII_FIRST, FONT_PLAIN);
 
-  setTMS99XXvramData(&tms99XX, c_tms99XX_ascii, sizeof(c_tms99XX_ascii));
+  /* inverted ascii chars 0x80 up for the highlight */
+  setTMS99XXfont(&tms99XX, &c_tms99XX_asciiFont, TMS99XX_ASCII_FIRST, TMS99XX_ASCII_NUMBER, TMS99XX_ASCII_FIRST + 0x80, FONT_INVERT);
 
-  /* invert ascii chars */
-  for(int inv_index = 0; inv_index < sizeof(c_tms99XX_ascii); inv_index++)
-  {
-    /**** write data to port from array of data at index ****/
-    VDP_DATA_PORT = ~(((uint8_t *)c_tms99XX_ascii)[inv_index]);
-  }
+#if !TMS99XX_ASCII_LOWER
+  /* BIOS font is upper case only, fold lower case onto the upper case glyphs */
+  setTMS99XXfont(&tms99XX, &c_tms99XX_asciiFont, 'A', 26, 'a', FONT_PLAIN);
+
+  setTMS99XXfont(&tms99XX, &c_tms99XX_asciiFont, 'A', 26, 'a' + 0x80, FONT_INVERT);
+#endif
+
+  /* rom name padding is 0, blank normal and solid highlighted */
+  setTMS99XXfont(&tms99XX, &c_tms99XX_asciiFont, ' ', 1, 0, FONT_PLAIN);
+
+  setTMS99XXfont(&tms99XX, &c_tms99XX_asciiFont, ' ', 1, 0x80, FONT_INVERT);
 
   /* first ascii letter is space in this table, no image */
   setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR);
@@ -98,13 +104,19 @@ void main(void)
   /* enable screen */
   setTMS99XXblank(&tms99XX, 0);
 
+  /* vdp irq paces the main loop */
+  setTMS99XXirq(&tms99XX, 1);
+
+  /* held up or down moves again after 16 frames, then every 6 */
+  set_input_repeat(16, 6);
+
   for(;;)
   {
     /* get controller one input */
-    uint16_t controller = getControllerOne();
+    get_input(0, &pad);
 
     /* when fire is pressed, start selected game */
-    if(!((controller >> FIRE_BIT) & 0x01))
+    if(pad.pressed & (1 << FIRE_BIT))
     {
       setTMS99XXvramWriteAddr(&tms99XX, NAME_TABLE_ADDR + (40 * 0));
       setTMS99XXvramData(&tms99XX, loading, sizeof(loading));
@@ -118,44 +130,20 @@ void main(void)
       buffer = *(bank_switch + index);
       buffer = *(bank_switch + index);
       buffer = *(bank_switch + index);
+      setTMS99XXirq(&tms99XX, 0);
       //It seems that Atari games do not like the reset. So halt and let the user
       //do it. User is slow enough to sync the systems without issue.
       __asm__("halt");
     }
-    /* when up is pressed, and its 0 shift a buffer till its 0, then decrement index to move the highlight up the screen */
-    else if(!((controller >> UP_BIT) & 0x01))
-    {
-      buffer = buffer << 1;
-
-      if(!buffer)
-      {
-        index = (index > 0 ? (index - 1) : num_of_roms-1);
-
-        buffer = (uint8_t)~0;
-      }
-    }
-    /* when down is pressed, and its 0 shift a buffer till its 0, then increment index to move the highlight down the screen */
-    else if(!((controller >> DOWN_BIT) & 0x01))
+    /* when up is pressed, or repeats, decrement index to move the highlight up the screen */
+    else if(pad.pressed & (1 << UP_BIT))
     {
-      buffer = buffer << 1;
-
-      if(!buffer)
-      {
-        index = (index < num_of_roms-1 ? (index + 1) : 0);
-
-        buffer = (uint8_t)~0;
-      }
+      index = (index > 0 ? (index - 1) : num_of_roms-1);
     }
-    /* nothing? then do a count to allow quick presses to shift the buffer, and if its been to long, clear everything out */
-    else
+    /* when down is pressed, or repeats, increment index to move the highlight down the screen */
+    else if(pad.pressed & (1 << DOWN_BIT))
     {
-      counter += 1;
-
-      if(counter > 32)
-      {
-        counter = 0;
-        buffer = (uint8_t)~0;
-      }
+      index = (index < num_of_roms-1 ? (index + 1) : 0);
     }
 
     /* a button has been pressed and passed indexs are no longer equal so we update the screen */
@@ -179,7 +167,7 @@ void main(void)
       prev_index = index;
     }
 
-    __delay_us(750);
+    wait_vblank();
   }
 }
 
@@ -10,39 +10,680 @@
 
 #include <stdint.h>
 
+/**
+ * @def ISR_GENERIC
+ * irq entry saves af, bc, de, hl, iy and calls the callback from c through
+ * vdp_irq, which counts frames and clears the vdp interrupt.
+ */
+#define ISR_GENERIC 0
+/**
+ * @def ISR_LEAN
+ * the callback address is patched into the vector jump, the callback is the
+ * interrupt handler. Declare it __critical __interrupt for an nmi (coleco
+ * vdp, sg1000 pause) or __interrupt for an int (coleco spin, sg1000 vdp). On
+ * msx the bios saved every register, any function works. The coleco vdp
+ * entry first tests the vdp lock, a frame landing in a locked sequence runs
+ * the handler from vdp_unlock. A lean handler that writes a vdp address has
+ * to put vdpAddr back to the vdp before it returns.
+ */
+#define ISR_LEAN    1
+/**
+ * @def ISR_SHADOW
+ * the vector jumps to an entry that swaps to the shadow registers, saves iy,
+ * and calls the callback, so a plain function works. Anything the
+ * interrupted code keeps in the shadow registers is lost, so code using them
+ * has to hold the vdp lock, as the pcm players do. di alone does not stop
+ * the coleco vdp nmi. Same as ISR_LEAN on msx.
+ */
+#define ISR_SHADOW  2
+/**
+ * @def ISR_MODE
+ * irq entry built in, pass -DISR_MODE=1 or 2 in the application CFLAGS. In
+ * the lean modes the callback has to bump frameCount and read the vdp status
+ * itself for wait_vblank, run_frames, and wait_frames.
+ */
+#ifndef ISR_MODE
+#define ISR_MODE ISR_GENERIC
+#endif
+
+/**
+ * @var frameCount
+ * vdp irqs seen, wraps at 256.
+ */
+extern volatile uint8_t frameCount;
+
+/**
+ * @def vdp_lock
+ * start a vdp port sequence that an irq must not split. Coleco takes the vdp
+ * irq on the NMI, so di does nothing there. Instead an NMI landing inside the
+ * lock only counts the frame, the callback and status read wait for the
+ * unlock, the vdp holds its interrupt till then. Other targets use di and ei.
+ */
+/**
+ * @def vdp_unlock
+ * end a vdp port sequence, on coleco runs an irq held back by the lock.
+ */
+/**
+ * @def vdp_track
+ * record the vram address main code set, the generic coleco entry puts it
+ * back after the vdp callback ran. rnw is 1 for a read address.
+ */
+/**
+ * @def vdp_move
+ * advance the recorded vram address by the bytes moved through the port.
+ */
+#if defined(_COLECO) || defined(_COLECO_SGM)
+extern volatile uint8_t vdpLock;
+
+extern volatile uint8_t vdpPending;
+
+extern volatile uint16_t vdpAddr;
+
 /***************************************************************************//**
- * @brief   delay in microseconds... at least close enough to it.
+ * @brief   run the vdp irq work an NMI held back, called by vdp_unlock.
+ ******************************************************************************/
+void vdp_irq_pending(void);
+
+#define vdp_lock() vdpLock++
+#define vdp_unlock() do { if(!--vdpLock && vdpPending) vdp_irq_pending(); } while(0)
+#define vdp_track(addr, rnw) (vdpAddr = (uint16_t)(((addr) & 0x3FFF) | ((rnw) ? 0x0000 : 0x4000)))
+#define vdp_move(size) (vdpAddr = (uint16_t)((vdpAddr & 0x4000) | ((vdpAddr + (size)) & 0x3FFF)))
+#else
+#define vdp_lock() di()
+#define vdp_unlock() ei()
+#define vdp_track(addr, rnw) ((void)0)
+#define vdp_move(size) ((void)0)
+#endif
+
+/**
+ * @def US_TO_TSTATES
+ * microseconds to CPU T-states at CPU_CLK, for constant arguments.
+ */
+#define US_TO_TSTATES(us) ((uint16_t)(((uint32_t)(us) * (CPU_CLK / 1000) + 500) / 1000))
+
+/***************************************************************************//**
+ * @brief   delay in CPU T-states, an assembly loop of 32 T-states. The call
+ *          itself is about 190 T-states, shorter delays return at once.
+ *          Interrupts that land during the delay add their own time.
+ *
+ * @param   tstates number of T-states to delay, up to about 18 ms.
+ ******************************************************************************/
+void __delay_tstates(uint16_t tstates);
+
+/***************************************************************************//**
+ * @brief   delay in microseconds, an assembly loop of 57 T-states that is 16 us
+ *          at CPU_CLK. Good to one loop, the call itself is about 50 us.
+ *          Interrupts that land during the delay add their own time.
  *
  * @param   count number of microseconds to delay.
  ******************************************************************************/
-void __delay_us(int count);
+void __delay_us(uint16_t count);
+
+/***************************************************************************//**
+ * @brief   halt till the next VDP interrupt, use to pace a main loop to the
+ *          frame. The VDP irq must be on (setTMS99XXirq), or this never
+ *          returns. Interrupts are enabled on return. With no vdp callback the
+ *          status is read for you, a callback must read it itself.
+ ******************************************************************************/
+void wait_vblank(void);
+
+/**
+ * @def FRAME_RENDER
+ * phase run once a frame first, right after vblank, for vram writes.
+ */
+#define FRAME_RENDER 0
+/**
+ * @def FRAME_UPDATE
+ * phase run once for every frame that passed, game logic.
+ */
+#define FRAME_UPDATE 1
+/**
+ * @def FRAME_PHASES
+ * number of phases, run in the order above.
+ */
+#define FRAME_PHASES 2
+/**
+ * @def FRAME_SLOTS
+ * tasks in each phase, run in slot order.
+ */
+#define FRAME_SLOTS 4
+/**
+ * @def FRAME_SKIP_MAX
+ * most updates run to catch up after an overrun, past this the game slows.
+ */
+#ifndef FRAME_SKIP_MAX
+#define FRAME_SKIP_MAX 4
+#endif
+
+/**
+ * @struct s_frameStats
+ * @brief Struct for frame scheduler timing.
+ */
+struct s_frameStats
+{
+  /**
+   * @var s_frameStats::frames
+   * frames rendered.
+   */
+  uint16_t frames;
+  /**
+   * @var s_frameStats::skipped
+   * frames updated without a render, logic overran the frame.
+   */
+  uint16_t skipped;
+  /**
+   * @var s_frameStats::used
+   * percent of the last frame spent in tasks and irqs, 100 on an overrun.
+   */
+  uint8_t used;
+  /**
+   * @var s_frameStats::peak
+   * highest used since measuring started.
+   */
+  uint8_t peak;
+};
+
+/***************************************************************************//**
+ * @brief   set a task for the frame scheduler, null clears the slot.
+ *
+ * @param   phase FRAME_RENDER or FRAME_UPDATE.
+ * @param   slot 0 to FRAME_SLOTS - 1, lower slots run first.
+ * @param   task function to call each frame.
+ ******************************************************************************/
+void set_frame_task(uint8_t phase, uint8_t slot, void (*task)(void));
 
 /***************************************************************************//**
- * @brief  tms99XX VDP interrupt is connected to NMI.
+ * @brief   measure how much of each frame the tasks use. The wait for the next
+ *          frame becomes a counted idle loop instead of a halt. Turning it on
+ *          counts one whole idle frame to calibrate and clears the stats.
+ *
+ * @param   measure 1 to measure, 0 to halt while waiting again.
+ ******************************************************************************/
+void set_frame_measure(uint8_t measure);
+
+/***************************************************************************//**
+ * @brief   copy the frame scheduler timing.
+ *
+ * @param   p_stats pointer to struct to fill.
+ ******************************************************************************/
+void get_frame_stats(struct s_frameStats * const p_stats);
+
+/***************************************************************************//**
+ * @brief   run the frame scheduler till stop_frames is called. Each vblank the
+ *          render tasks run, then the update tasks once for every frame that
+ *          passed, up to FRAME_SKIP_MAX. The VDP irq must be on, interrupts are
+ *          enabled.
+ ******************************************************************************/
+void run_frames(void);
+
+/***************************************************************************//**
+ * @brief   make run_frames return once the current frame's tasks finish.
+ ******************************************************************************/
+void stop_frames(void);
+
+/**
+ * @def TASKS_MAX
+ * cooperative tasks that can run at once.
+ */
+#ifndef TASKS_MAX
+#define TASKS_MAX 4
+#endif
+/**
+ * @def TASK_STACK_MIN
+ * smallest task stack. An irq landing in a task runs on the task stack, the
+ * generic entry with vdp_irq, scan_input, and updateInput is about 48 bytes,
+ * a coleco spinner irq under it about 24 more. With the 8 byte start frame
+ * and a little for the task that is 96. The vdp irq callback runs there too,
+ * add its depth and the task's own calls on top.
+ */
+#define TASK_STACK_MIN 96
+/**
+ * @def TASK_READY
+ * task runs on the next run_tasks once its wake frame comes.
+ */
+#define TASK_READY 1
+/**
+ * @def TASK_DONE
+ * task returned or was stopped.
+ */
+#define TASK_DONE 0
+
+/**
+ * @struct s_task
+ * @brief Struct for a cooperative task, the stack is separate.
+ */
+struct s_task
+{
+  /**
+   * @var s_task::sp
+   * stack pointer saved when the task yields.
+   */
+  uint16_t sp;
+  /**
+   * @var s_task::wake
+   * frame count the task waits for.
+   */
+  uint8_t wake;
+  /**
+   * @var s_task::state
+   * TASK_READY or TASK_DONE.
+   */
+  uint8_t state;
+};
+
+/***************************************************************************//**
+ * @brief   start a cooperative task. It runs on its own stack from the next
+ *          run_tasks till it calls yield or wait_frames, returning ends it.
+ *
+ * @param   p_task pointer to struct to contain task data.
+ * @param   entry function the task runs.
+ * @param   p_stack stack memory for the task, kept till it is done.
+ * @param   size bytes of stack, TASK_STACK_MIN plus the vdp irq callback
+ *          depth and the task's own calls.
+ *
+ * @return  1 when started, 0 when all TASKS_MAX run or the stack is short.
+ ******************************************************************************/
+uint8_t start_task(struct s_task * const p_task, void (*entry)(void), uint8_t * const p_stack, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   stop a task that is not the one running, its stack is free after.
+ *
+ * @param   p_task pointer to struct of the task.
+ ******************************************************************************/
+void stop_task(struct s_task * const p_task);
+
+/***************************************************************************//**
+ * @brief   check if a task still runs.
+ *
+ * @param   p_task pointer to struct of the task.
+ *
+ * @return  1 while the task runs, 0 when done.
+ ******************************************************************************/
+uint8_t get_task_busy(struct s_task * const p_task);
+
+/***************************************************************************//**
+ * @brief   give each ready task one turn, in start order. Call once a frame,
+ *          from the main loop or as a FRAME_UPDATE task.
+ ******************************************************************************/
+void run_tasks(void);
+
+/***************************************************************************//**
+ * @brief   give up the rest of the task's turn, it goes on at the next
+ *          run_tasks. Returns at once outside a task.
+ ******************************************************************************/
+void yield(void);
+
+/***************************************************************************//**
+ * @brief   yield till frames vdp irqs have passed.
+ *
+ * @param   frames number of frames to wait, up to 127.
+ ******************************************************************************/
+void wait_frames(uint8_t frames);
+
+/***************************************************************************//**
+ * @brief  tms99XX VDP interrupt is connected to NMI. With ISR_MODE lean the
+ *         vector jump is patched to a short entry that tests the vdp lock
+ *         and jumps to the callback, null puts the generic entry back.
  *
  * @param  callback a function to use to parse vdp.
  ******************************************************************************/
 void set_vdp_irq_callback(void (*callback)(void));
 
 /***************************************************************************//**
- * @brief   coleco spinner irq callback
+ * @brief   coleco spinner irq callback, the pause nmi on sg1000. With ISR_MODE
+ *          lean the vector jump is patched the same as the vdp callback.
  *
  * @param   callback a function to use to parse spin.
  ******************************************************************************/
 void set_spin_irq_callback(void (*callback)(void));
 
+/**
+ * @def POOL_NONE
+ * no block, the pool is empty.
+ */
+#define POOL_NONE 0xFF
+/**
+ * @def POOL_BYTES
+ * memory a pool of blocks of size bytes needs, blocks up to 254.
+ */
+#define POOL_BYTES(size, blocks) ((uint16_t)(size) * (blocks))
+
+/**
+ * @struct s_pool
+ * @brief Struct for a pool of fixed size blocks found by 8 bit index.
+ */
+struct s_pool
+{
+  /**
+   * @var s_pool::p_mem
+   * block memory, free blocks hold the index of the next free block.
+   */
+  uint8_t *p_mem;
+  /**
+   * @var s_pool::size
+   * bytes a block.
+   */
+  uint8_t size;
+  /**
+   * @var s_pool::blocks
+   * number of blocks.
+   */
+  uint8_t blocks;
+  /**
+   * @var s_pool::next
+   * first free block, POOL_NONE when full.
+   */
+  uint8_t next;
+  /**
+   * @var s_pool::used
+   * blocks handed out.
+   */
+  uint8_t used;
+};
+
+/**
+ * @struct s_arena
+ * @brief Struct for a bump allocator, freed all at once or back to a mark.
+ */
+struct s_arena
+{
+  /**
+   * @var s_arena::p_mem
+   * arena memory.
+   */
+  uint8_t *p_mem;
+  /**
+   * @var s_arena::size
+   * bytes of memory.
+   */
+  uint16_t size;
+  /**
+   * @var s_arena::top
+   * bytes handed out, also the mark.
+   */
+  uint16_t top;
+};
+
 /***************************************************************************//**
- * @brief   read controller one port.
+ * @brief   set up a pool and chain every block free.
+ *
+ * @param   p_pool pointer to struct to contain pool data.
+ * @param   p_mem memory of at least POOL_BYTES(size, blocks).
+ * @param   size bytes a block, at least 1.
+ * @param   blocks number of blocks, up to 254.
+ ******************************************************************************/
+void init_pool(struct s_pool * const p_pool, void * const p_mem, uint8_t size, uint8_t blocks);
+
+/***************************************************************************//**
+ * @brief   take a block off the free chain.
+ *
+ * @param   p_pool pointer to struct of the pool.
+ *
+ * @return  block index, POOL_NONE when the pool is full.
+ ******************************************************************************/
+uint8_t alloc_pool(struct s_pool * const p_pool);
+
+/***************************************************************************//**
+ * @brief   put a block back on the free chain, freeing a block twice is not
+ *          caught and breaks the chain.
+ *
+ * @param   p_pool pointer to struct of the pool.
+ * @param   index block index from alloc_pool.
+ ******************************************************************************/
+void free_pool(struct s_pool * const p_pool, uint8_t index);
+
+/***************************************************************************//**
+ * @brief   memory of a block.
+ *
+ * @param   p_pool pointer to struct of the pool.
+ * @param   index block index from alloc_pool.
+ *
+ * @return  pointer to the block, null for a bad index.
+ ******************************************************************************/
+void *get_pool_block(struct s_pool * const p_pool, uint8_t index);
+
+/***************************************************************************//**
+ * @brief   set up an arena over memory the caller owns.
+ *
+ * @param   p_arena pointer to struct to contain arena data.
+ * @param   p_mem arena memory.
+ * @param   size bytes of memory.
+ ******************************************************************************/
+void init_arena(struct s_arena * const p_arena, void * const p_mem, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   set up an arena over the _HEAP area, from the end of the
+ *          variables up to the stack less a reserve. Call from main before
+ *          the stack grows.
+ *
+ * @param   p_arena pointer to struct to contain arena data.
+ * @param   stackReserve bytes left below the stack pointer for the stack.
+ *
+ * @return  bytes in the arena.
+ ******************************************************************************/
+uint16_t init_heap_arena(struct s_arena * const p_arena, uint16_t stackReserve);
+
+/***************************************************************************//**
+ * @brief   hand out bytes from the top of the arena.
+ *
+ * @param   p_arena pointer to struct of the arena.
+ * @param   size bytes wanted.
+ *
+ * @return  pointer to the bytes, null when the arena is out.
+ ******************************************************************************/
+void *alloc_arena(struct s_arena * const p_arena, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   mark to go back to, take one at the start of a level or frame.
+ *
+ * @param   p_arena pointer to struct of the arena.
+ *
+ * @return  the mark.
+ ******************************************************************************/
+uint16_t get_arena_mark(struct s_arena * const p_arena);
+
+/***************************************************************************//**
+ * @brief   free everything handed out after a mark, 0 frees it all.
+ *
+ * @param   p_arena pointer to struct of the arena.
+ * @param   mark from get_arena_mark.
+ ******************************************************************************/
+void set_arena_mark(struct s_arena * const p_arena, uint16_t mark);
+
+/***************************************************************************//**
+ * @brief   bytes the arena has left.
+ *
+ * @param   p_arena pointer to struct of the arena.
+ *
+ * @return  free bytes.
+ ******************************************************************************/
+uint16_t get_arena_free(struct s_arena * const p_arena);
+
+/**
+ * @def STACK_CHECK
+ * 1 builds the stack instrumentation, pass -DSTACK_CHECK=1 in the
+ * application CFLAGS. crt0 then fills the RAM from the end of the variables
+ * up to the stack with STACK_CANARY before gsinit.
+ */
+#ifndef STACK_CHECK
+#define STACK_CHECK 0
+#endif
+/**
+ * @def STACK_CANARY
+ * fill byte of the unused stack.
+ */
+#define STACK_CANARY 0xA5
+/**
+ * @def STACK_GUARD
+ * bytes at the bottom of the stack region that must keep the canary, any
+ * change there is reported as damage.
+ */
+#define STACK_GUARD 16
+
+/**
+ * @struct s_stackStats
+ * @brief Struct for the stack high water mark.
+ */
+struct s_stackStats
+{
+  /**
+   * @var s_stackStats::size
+   * bytes from the bottom of the stack region to STACK_TOP.
+   */
+  uint16_t size;
+  /**
+   * @var s_stackStats::peak
+   * deepest the stack has been, in bytes below STACK_TOP.
+   */
+  uint16_t peak;
+  /**
+   * @var s_stackStats::damaged
+   * 1 when the guard bytes lost the canary, the stack ran into the heap or
+   * the variables.
+   */
+  uint8_t damaged;
+};
+
+/***************************************************************************//**
+ * @brief   fill the stack region with STACK_CANARY, called from crt0 with
+ *          the stack set. Only returns without STACK_CHECK.
+ ******************************************************************************/
+void stack_fill(void);
+
+/***************************************************************************//**
+ * @brief   scan the stack region for the high water mark. The region starts
+ *          at the end of the variables, or at the end of the heap arena
+ *          once init_heap_arena placed it. Scans the whole region, debug use.
+ *
+ * @param   p_stats pointer to struct to contain the stack stats.
+ *
+ * @return  1 for stats, 0 when built without STACK_CHECK.
+ ******************************************************************************/
+uint8_t get_stack_stats(struct s_stackStats * const p_stats);
+
+/***************************************************************************//**
+ * @brief   controller one as read at the last vdp irq, active low.
  *
  * @return  A unsigned 16 bit number contains all controller states.
  ******************************************************************************/
 uint16_t getControllerOne();
 
 /***************************************************************************//**
- * @brief   read controller two port.
+ * @brief   controller two as read at the last vdp irq, active low.
  *
  * @return  A unsigned 16 bit number contains all controller states.
  ******************************************************************************/
 uint16_t getControllerTwo();
 
+/**
+ * @def INPUT_CONTROLLERS
+ * controllers the input service keeps.
+ */
+#define INPUT_CONTROLLERS 2
+/**
+ * @def INPUT_BUTTONS
+ * joystick and button bits of an s_input mask, active high.
+ */
+#define INPUT_BUTTONS ((1 << UP_BIT) | (1 << DOWN_BIT) | (1 << LEFT_BIT) | (1 << RIGHT_BIT) | (1 << FIRE_BIT) | (1 << ARM_BIT))
+/**
+ * @def INPUT_KEY
+ * bit of an s_input mask set while a keypad key is down.
+ */
+#define INPUT_KEY (1 << KEYPAD_BIT)
+/**
+ * @def KEY_STAR
+ * keypad star, keys 0 to 9 decode to their number.
+ */
+#define KEY_STAR 10
+/**
+ * @def KEY_POUND
+ * keypad pound.
+ */
+#define KEY_POUND 11
+/**
+ * @def KEY_NONE
+ * no keypad key down.
+ */
+#define KEY_NONE 0xFF
+
+/**
+ * @struct s_input
+ * @brief Struct for one controller from the input service.
+ */
+struct s_input
+{
+  /**
+   * @var s_input::held
+   * INPUT_BUTTONS and INPUT_KEY bits down at the last scan.
+   */
+  uint16_t held;
+  /**
+   * @var s_input::pressed
+   * bits that went down, and auto repeats, since the last get_input.
+   */
+  uint16_t pressed;
+  /**
+   * @var s_input::released
+   * bits that went up since the last get_input.
+   */
+  uint16_t released;
+  /**
+   * @var s_input::key
+   * keypad key down, 0 to 9, KEY_STAR, KEY_POUND, or KEY_NONE.
+   */
+  uint8_t key;
+};
+
+/**
+ * @var c_keypadDecode
+ * keypad nibble of a controller read to a key, KEY_NONE for no key. Coleco
+ * targets only, msx has no keypad and s_input::key stays KEY_NONE.
+ */
+extern const uint8_t c_keypadDecode[16];
+
+/***************************************************************************//**
+ * @brief   copy a controller from the input service and clear its pressed and
+ *          released bits. Both controllers are read once a frame from the vdp
+ *          irq, sampling at the frame rate debounces the buttons and a keypad
+ *          key has to read the same two frames running.
+ *
+ * @param   controller 0 or 1.
+ * @param   p_input pointer to struct to fill.
+ ******************************************************************************/
+void get_input(uint8_t controller, struct s_input * const p_input);
+
+/***************************************************************************//**
+ * @brief   auto repeat for held buttons, they show up in pressed again after
+ *          delay frames and then every rate frames.
+ *
+ * @param   delay frames before the first repeat, 0 turns repeat off.
+ * @param   rate frames between repeats after that.
+ ******************************************************************************/
+void set_input_repeat(uint8_t delay, uint8_t rate);
+
+/***************************************************************************//**
+ * @brief   read the controllers into the input service, the generic vdp irq
+ *          does this, call it from a lean ISR_MODE handler.
+ ******************************************************************************/
+void scan_input(void);
+
+/***************************************************************************//**
+ * @brief   spinner motion since the last call, then reset, call once a frame.
+ *          The super action and roller controller spinners raise the coleco
+ *          spin irq a step at a time, the generic spin_irq adds each step
+ *          before the spin callback. Coleco targets only.
+ *
+ * @param   controller 0 or 1.
+ *
+ * @return  signed steps, the sign follows the spin direction.
+ ******************************************************************************/
+int8_t get_spinner(uint8_t controller);
+
+/***************************************************************************//**
+ * @brief   minimal spinner isr, saves af and hl, adds the step, and returns.
+ *          With ISR_MODE ISR_LEAN pass it to set_spin_irq_callback so the
+ *          vector jumps straight to it. Coleco targets only.
+ ******************************************************************************/
+void spinner_irq(void);
+
 #endif
@@ -15,9 +15,12 @@
 #define KEYPAD_BIT   8
 #define KEYPAD_MASK  0x0F
 
+#define CPU_CLK           3579545
+#define STACK_TOP         0x7400
 #define VDP_DATA_ADDR     0xBE
 #define VDP_REG_ADDR      0xBF
 #define SN_SND_ADDR       0xFF
+#define SN_SND_CLK        3579545
 #define CTRL_STR_SET_ADDR 0x80
 #define CTRL_STR_RST_ADDR 0xC0
 #define CTRL_ONE_ADDR     0xFC
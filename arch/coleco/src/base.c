@@ -9,31 +9,291 @@ volatile void (*vdp_callback)(void) = 0;
 
 volatile void (*spin_callback)(void) = 0;
 
-void __delay_us(int count)
+/* frames seen by vdp_irq, wait_vblank halts till it changes */
+volatile uint8_t frameCount = 0;
+
+/* vdp lock from base.h, an nmi inside a locked sequence waits for the unlock */
+volatile uint8_t vdpLock = 0;
+
+volatile uint8_t vdpPending = 0;
+
+volatile uint16_t vdpAddr = 0;
+
+/* controllers read once a frame in vdp_irq, active low */
+volatile uint16_t controllerOne = 0xFFFF;
+
+volatile uint16_t controllerTwo = 0xFFFF;
+
+/* input service in arch/src/input.c, scan_input feeds it a raw read */
+void updateInput(uint8_t controller, uint16_t raw);
+
+/* spinner steps since the last get_spinner, one per controller */
+volatile int8_t spinDelta[INPUT_CONTROLLERS] = {0};
+
+#if ISR_MODE != ISR_GENERIC
+/* crt0 entries the vector jumps go back to, or through for shadow */
+void irq_nmi(void);
+
+void irq_nmi_lean(void);
+
+void irq_nmi_shadow(void);
+
+void irq_spin(void);
+
+void irq_spin_shadow(void);
+
+/* address the patch helpers write */
+static uint16_t isrTarget = 0;
+
+/* a lean or shadow vdp handler is in, vdp_unlock runs it through vdp_call */
+static uint8_t isrHeld = 0;
+#endif
+
+// halt till vdp_irq counts a frame, the nmi can not be masked so one landing
+// between the count read and the halt costs a frame.
+void wait_vblank(void) __naked
 {
-  for(; count > 0; count--)
+  __asm
+    ld  a, (_frameCount)
+    ld  b, a
+  00100$:
+    halt
+    ld  a, (_frameCount)
+    cp  a, b
+    jr  z, 00100$
+    ret
+  __endasm;
+}
+
+// run the callback and put back the vram address main code had set.
+static void vdpService(void)
+{
+  uint16_t addr = vdpAddr;
+
+  scan_input();
+
+  if(vdp_callback)
   {
+    (*vdp_callback)();
+
+    vdpAddr = addr;
+
+    VDP_REG_PORT = (uint8_t)addr;
+
+    VDP_REG_PORT = (uint8_t)(addr >> 8);
+  }
+  else
+  {
+    // nothing will read status, read it here to clear the vdp interrupt.
     __asm
-      nop
+      in  a, (_VDP_REG_PORT)
     __endasm;
   }
 }
 
 void vdp_irq(void)
 {
-  if(vdp_callback) (*vdp_callback)();
+  frameCount++;
+
+  // main code is inside a vdp sequence, the vdp holds its interrupt till the unlock.
+  if(vdpLock)
+  {
+    vdpPending = 1;
+
+    return;
+  }
+
+  // a held frame this one covers, vdp_unlock must not run it again.
+  vdpPending = 0;
+
+  vdpService();
+}
+
+#if ISR_MODE != ISR_GENERIC
+// run a lean or shadow handler held back by the lock, a lean handler ends in
+// retn, outside an nmi that returns the same as ret.
+static void vdpHeld(void) __naked
+{
+  __asm
+    push ix
+    push iy
+    call _vdp_call
+    pop iy
+    pop ix
+    ret
+  __endasm;
+}
+#endif
+
+// locked so a frame landing in a long callback waits, checked again after the unlock.
+void vdp_irq_pending(void)
+{
+  do
+  {
+    vdpLock++;
+
+    vdpPending = 0;
+
+#if ISR_MODE != ISR_GENERIC
+    if(isrHeld)
+    {
+      vdpHeld();
+
+      VDP_REG_PORT = (uint8_t)vdpAddr;
+
+      VDP_REG_PORT = (uint8_t)(vdpAddr >> 8);
+    }
+    else
+    {
+      vdpService();
+    }
+#else
+    vdpService();
+#endif
+
+    vdpLock--;
+  } while(vdpPending);
+}
+
+// a spinner that moved holds bit 4 low, bit 5 high steps back, one step an irq.
+static void spinRead(void) __naked
+{
+  __asm
+    in  a, (_CTRL_ONE_PORT)
+    bit 4, a
+    jr  nz, 00101$
+    ld  hl, #_spinDelta
+    bit 5, a
+    jr  z, 00100$
+    dec (hl)
+    jr  00101$
+  00100$:
+    inc (hl)
+  00101$:
+    in  a, (_CTRL_TWO_PORT)
+    bit 4, a
+    ret nz
+    ld  hl, #_spinDelta + 1
+    bit 5, a
+    jr  z, 00102$
+    dec (hl)
+    ret
+  00102$:
+    inc (hl)
+    ret
+  __endasm;
+}
+
+// complete spinner isr for a lean ISR_MODE, only af and hl are used.
+void spinner_irq(void) __naked
+{
+  __asm
+    push af
+    push hl
+    call _spinRead
+    pop hl
+    pop af
+    ei
+    reti
+  __endasm;
 }
 
 void spin_irq(void)
 {
+  spinRead();
+
   if(spin_callback) (*spin_callback)();
 }
 
+int8_t get_spinner(uint8_t controller)
+{
+  int8_t delta = 0;
+
+  if(controller >= INPUT_CONTROLLERS) return 0;
+
+  // the spinner irq is maskable, di holds it off.
+  di();
+
+  delta = spinDelta[controller];
+
+  spinDelta[controller] = 0;
+
+  ei();
+
+  return delta;
+}
+
+#if ISR_MODE != ISR_GENERIC
+// write isrTarget into a jump in one instruction, an nmi sees old or new.
+static void patchVdpVector(void) __naked
+{
+  __asm
+    ld  hl, (_isrTarget)
+    ld  (_vdp_vector + 1), hl
+    ret
+  __endasm;
+}
+
+static void patchVdpCall(void) __naked
+{
+  __asm
+    ld  hl, (_isrTarget)
+    ld  (_vdp_call + 1), hl
+    ret
+  __endasm;
+}
+
+static void patchSpinVector(void) __naked
+{
+  __asm
+    ld  hl, (_isrTarget)
+    ld  (_spin_vector + 1), hl
+    ret
+  __endasm;
+}
+
+static void patchSpinCall(void) __naked
+{
+  __asm
+    ld  hl, (_isrTarget)
+    ld  (_spin_call + 1), hl
+    ret
+  __endasm;
+}
+#endif
+
 void set_vdp_irq_callback(void (*callback)(void))
 {
   di();
 
+#if ISR_MODE == ISR_GENERIC
   vdp_callback = callback;
+#else
+  if(callback)
+  {
+    // the entry tests the vdp lock, then goes through vdp_call to the handler.
+    isrTarget = (uint16_t)callback;
+
+    patchVdpCall();
+
+    isrHeld = 1;
+
+#if ISR_MODE == ISR_SHADOW
+    isrTarget = (uint16_t)irq_nmi_shadow;
+#else
+    isrTarget = (uint16_t)irq_nmi_lean;
+#endif
+  }
+  else
+  {
+    // null goes back to the generic entry so frames still count.
+    isrTarget = (uint16_t)irq_nmi;
+  }
+
+  patchVdpVector();
+
+  if(!callback) isrHeld = 0;
+#endif
 
   ei();
 }
@@ -42,43 +302,73 @@ void set_spin_irq_callback(void (*callback)(void))
 {
   di();
 
+#if ISR_MODE == ISR_GENERIC
   spin_callback = callback;
+#else
+  isrTarget = (callback ? (uint16_t)callback : (uint16_t)irq_spin);
+
+#if ISR_MODE == ISR_SHADOW
+  if(callback)
+  {
+    patchSpinCall();
+
+    isrTarget = (uint16_t)irq_spin_shadow;
+  }
+#endif
+
+  patchSpinVector();
+#endif
 
   ei();
 }
 
-// read controller one port.
+// controller one as read at the last vdp irq.
 uint16_t getControllerOne()
 {
   uint16_t temp = 0;
 
-  CTRL_STR_SET_PORT = 0;
-  CTRL_STR_RST_PORT = 1;
-
-  temp = CTRL_ONE_PORT & 0x00FF;
+  vdp_lock();
 
-  CTRL_STR_RST_PORT = 0;
-  CTRL_STR_SET_PORT = 1;
+  temp = controllerOne;
 
-  temp |= CTRL_ONE_PORT << 8;
+  vdp_unlock();
 
   return temp;
 }
 
-// read controller two port.
+// controller two as read at the last vdp irq.
 uint16_t getControllerTwo()
 {
   uint16_t temp = 0;
 
-  CTRL_STR_SET_PORT = 0;
-  CTRL_STR_RST_PORT = 1;
+  vdp_lock();
 
-  temp = CTRL_TWO_PORT & 0x00FF;
+  temp = controllerTwo;
 
+  vdp_unlock();
+
+  return temp;
+}
+
+void scan_input(void)
+{
+  uint8_t joyOne = 0;
+  uint8_t joyTwo = 0;
+
+  // one strobe sequence, joystick mode for both, then keypad mode for both.
   CTRL_STR_RST_PORT = 0;
-  CTRL_STR_SET_PORT = 1;
 
-  temp |= CTRL_TWO_PORT << 8;
+  joyOne = CTRL_ONE_PORT;
 
-  return temp;
+  joyTwo = CTRL_TWO_PORT;
+
+  CTRL_STR_SET_PORT = 0;
+
+  controllerOne = ((uint16_t)CTRL_ONE_PORT << 8) | joyOne;
+
+  controllerTwo = ((uint16_t)CTRL_TWO_PORT << 8) | joyTwo;
+
+  updateInput(0, controllerOne);
+
+  updateInput(1, controllerTwo);
 }
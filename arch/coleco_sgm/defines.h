@@ -6,9 +6,21 @@
 #ifndef __DEFINES
 #define __DEFINES
 
+#define UP_BIT       0
+#define LEFT_BIT     3
+#define DOWN_BIT     2
+#define RIGHT_BIT    1
+#define FIRE_BIT     6
+#define ARM_BIT      14
+#define KEYPAD_BIT   8
+#define KEYPAD_MASK  0x0F
+
+#define CPU_CLK           3579545
+#define STACK_TOP         0x8000
 #define VDP_DATA_ADDR     0xBE
 #define VDP_REG_ADDR      0xBF
 #define SN_SND_ADDR       0xFF
+#define SN_SND_CLK        3579545
 #define CTRL_STR_SET_ADDR 0x80
 #define CTRL_STR_RST_ADDR 0xC0
 #define CTRL_ONE_ADDR     0xFC
@@ -16,6 +28,7 @@
 #define GI_SND_CP_ADDR    0x50
 #define GI_SND_WDATA_ADDR 0x51
 #define GI_SND_RDATA_ADDR 0x52
+#define GI_SND_CLK        1789772
 
 __sfr __at(VDP_DATA_ADDR)     VDP_DATA_PORT;
 __sfr __at(VDP_REG_ADDR)      VDP_REG_PORT;
@@ -6,13 +6,19 @@
 
     _SGM_RAM_ENA_PORT     .equ 0x0053
     _SGM_BIOS_SWAP_PORT   .equ 0x007F
-    _NMI_SIZE             .equ (_irq_nmi_end - _irq_nmi + 1)
-    _SPIN_SIZE            .equ (_irq_spin_end - _irq_spin + 1)
+    _vdp_vector           == 0x0066
+    _spin_vector          == 0x0038
 
    .module crt0
    .globl _main
+   .globl _stack_fill
    .globl _vdp_irq
    .globl _spin_irq
+   .globl _vdp_call
+   .globl _spin_call
+   .globl _vdpLock
+   .globl _vdpPending
+   .globl _vdpAddr
 
    .area _HEADER(ABS)
    .org 0x8000
@@ -55,18 +61,18 @@ _init:
   ld (0x21),a
   ld (0x29),a
   ld (0x31),a
-  ;copy code to ram
-  ;nmi first
-  ld bc, #_NMI_SIZE
-  ld hl, #_irq_nmi
-  ld de, #0x0066
-  ldir
-  ;spin
-  ld bc, #_SPIN_SIZE
-  ld hl, #_irq_spin
-  ld de, #0x0038
-  ldir
+  ;irq vectors are jumps in ram so the callback setters can patch them
+  ld a,#0xC3
+  ld (_vdp_vector),a
+  ld (_spin_vector),a
+  ld (_vdp_call),a
+  ld (_spin_call),a
+  ld hl,#_irq_nmi
+  ld (_vdp_vector + 1),hl
+  ld hl,#_irq_spin
+  ld (_spin_vector + 1),hl
   ld	sp, #0x8000
+  call _stack_fill
   call gsinit
   call  _main
   rst   0x0
@@ -74,17 +80,27 @@ _init:
   ;; copied from sdcc src/z80/crt0.s
   .area _HOME
   .area _CODE
-  .area _INITIALIZER
   .area _GSINIT
   .area _GSFINAL
+  .area _INITIALIZER
   .area _DATA
+  .area _VECTORS
   .area _INITIALIZED
   .area _BSEG
   .area _BSS
   .area _HEAP
+_heap_start::
+
+  ;; jp opcode and address, patched by the callback setters, kept out of
+  ;; _DATA so gsinit does not clear them
+  .area _VECTORS
+_vdp_call:
+  .ds 3
+_spin_call:
+  .ds 3
 
   .area _CODE
-_irq_nmi:
+_irq_nmi::
   push af
   push bc
   push de
@@ -97,9 +113,8 @@ _irq_nmi:
   pop bc
   pop af
   retn
-_irq_nmi_end:
 
-_irq_spin:
+_irq_spin::
   push af
   push bc
   push de
@@ -111,19 +126,158 @@ _irq_spin:
   pop de
   pop bc
   pop af
+  ei
+  reti
+
+  ;; lean entry, jumps to the handler unless main code holds the vdp lock,
+  ;; a held frame this one covers is dropped
+_irq_nmi_lean::
+  push af
+  ld a, (_vdpLock)
+  or a, a
+  jr NZ, irq_nmi_held
+  ld (_vdpPending), a
+  pop af
+  jp _vdp_call
+
+  ;; lean entry for handlers that only need the shadow registers, the lock is
+  ;; tested before the swap and the vram address main code set is put back
+_irq_nmi_shadow::
+  push af
+  ld a, (_vdpLock)
+  or a, a
+  jr NZ, irq_nmi_held
+  ld (_vdpPending), a
+  pop af
+  ex af, af'
+  exx
+  push iy
+  call _vdp_call
+  pop iy
+  ld hl, (_vdpAddr)
+  ld a, l
+  out (0xBF), a
+  ld a, h
+  out (0xBF), a
+  exx
+  ex af, af'
+  retn
+
+  ;; main code holds the vdp lock, vdp_unlock runs the handler
+irq_nmi_held:
+  ld a, #1
+  ld (_vdpPending), a
+  pop af
+  retn
+
+_irq_spin_shadow::
+  ex af, af'
+  exx
+  push iy
+  call _spin_call
+  pop iy
+  exx
+  ex af, af'
+  ei
   reti
-_irq_spin_end:
+
+  ;; zero a block, hl start and bc length, 8 stores a pass
+gsinit_zero:
+  ld a, c
+  and a, #0x07
+  ld e, a
+  srl b
+  rr c
+  srl b
+  rr c
+  srl b
+  rr c
+  xor a, a
+  ld d, a
+  ld a, b
+  or a, c
+  jr Z, gsinit_zero_tail
+gsinit_zero_block:
+  ld (hl), d
+  inc hl
+  ld (hl), d
+  inc hl
+  ld (hl), d
+  inc hl
+  ld (hl), d
+  inc hl
+  ld (hl), d
+  inc hl
+  ld (hl), d
+  inc hl
+  ld (hl), d
+  inc hl
+  ld (hl), d
+  inc hl
+  dec bc
+  ld a, b
+  or a, c
+  jr NZ, gsinit_zero_block
+gsinit_zero_tail:
+  ld a, e
+  or a, a
+  ret Z
+  ld b, e
+gsinit_zero_byte:
+  ld (hl), d
+  inc hl
+  djnz gsinit_zero_byte
+  ret
+
+  ;; set to 1 by py/initpack.py when it packed the initializer
+_init_packed::
+  .db 0
 
 ;; copied from sdcc src/z80/crt0.s
   .area   _GSINIT
 gsinit::
+  ;; variables without an initializer start at zero
+  ld hl, #s__DATA
+  ld bc, #l__DATA
+  call gsinit_zero
+  ld hl, #s__BSS
+  ld bc, #l__BSS
+  call gsinit_zero
+
   ld bc, #l__INITIALIZER
   ld a, b
   or a, c
   jr Z, gsinit_next
   ld de, #s__INITIALIZED
   ld hl, #s__INITIALIZER
+  ld a, (_init_packed)
+  or a, a
+  jr NZ, gsinit_unpack
+  ldir
+  jr gsinit_next
+
+  ;; packed runs, 0 ends, 1 to 127 literal bytes follow, 128 to 255 is
+  ;; the next byte repeated 2 to 129 times
+gsinit_unpack:
+  ld a, (hl)
+  inc hl
+  or a, a
+  jr Z, gsinit_next
+  jp M, gsinit_run
+  ld c, a
+  ld b, #0
   ldir
+  jr gsinit_unpack
+gsinit_run:
+  sub a, #126
+  ld b, a
+  ld a, (hl)
+  inc hl
+gsinit_fill:
+  ld (de), a
+  inc de
+  djnz gsinit_fill
+  jr gsinit_unpack
 gsinit_next:
   .area   _GSFINAL
   ret
@@ -6,6 +6,16 @@
 #ifndef __DEFINES
 #define __DEFINES
 
+#define UP_BIT       0
+#define DOWN_BIT     1
+#define LEFT_BIT     2
+#define RIGHT_BIT    3
+#define FIRE_BIT     4
+#define ARM_BIT      5
+#define KEYPAD_BIT   8
+
+#define CPU_CLK           3579545
+#define STACK_TOP         0xF000
 #define VDP_DATA_ADDR     0x98
 #define VDP_REG_ADDR      0x99
 #define CTRL_STR_SET_ADDR 0x80
@@ -15,6 +25,7 @@
 #define GI_SND_CP_ADDR    0xA0
 #define GI_SND_WDATA_ADDR 0xA1
 #define GI_SND_RDATA_ADDR 0xA2
+#define GI_SND_CLK        1789772
 
 __sfr __at(VDP_DATA_ADDR)     VDP_DATA_PORT;
 __sfr __at(VDP_REG_ADDR)      VDP_REG_PORT;
@@ -9,18 +9,75 @@ volatile void (*vdp_callback)(void) = 0;
 
 volatile void (*spin_callback)(void) = 0;
 
-void __delay_us(int count)
+/* frames seen by vdp_irq, wait_vblank halts till it changes */
+volatile uint8_t frameCount = 0;
+
+#if ISR_MODE != ISR_GENERIC
+/* crt0 entry the H.TIMI hook goes back to */
+void irq_timi(void);
+
+/* address the patch helper writes */
+static uint16_t isrTarget = 0;
+#endif
+
+/* joysticks read once a frame in vdp_irq, active low, no keypad */
+volatile uint16_t controllerOne = 0xFFFF;
+
+volatile uint16_t controllerTwo = 0xFFFF;
+
+/* input service in arch/src/input.c, scan_input feeds it a raw read */
+void updateInput(uint8_t controller, uint16_t raw);
+
+/* psg io registers, port B bit 6 selects the joystick read on port A */
+#define PSG_IO_A      14
+#define PSG_IO_B      15
+#define PSG_KANA_LED  0x80
+#define PSG_JOY_TWO   0x40
+#define PSG_PINS_HIGH 0x3F
+#define JOY_UNUSED    0xFFC0
+
+// select a joystick and read its pins through the psg.
+static uint16_t readJoystick(uint8_t select)
 {
-  for(; count > 0; count--)
-  {
-    __asm
-      nop
-    __endasm;
-  }
+  uint8_t portB = 0;
+
+  GI_SND_CP_PORT = PSG_IO_B;
+
+  portB = GI_SND_RDATA_PORT;
+
+  GI_SND_WDATA_PORT = (portB & PSG_KANA_LED) | PSG_PINS_HIGH | select;
+
+  GI_SND_CP_PORT = PSG_IO_A;
+
+  return JOY_UNUSED | GI_SND_RDATA_PORT;
+}
+
+// halt till vdp_irq counts a frame, ei takes effect after the halt so the
+// irq can not land between the count check and the halt.
+void wait_vblank(void) __naked
+{
+  __asm
+    di
+    ld  a, (_frameCount)
+    ld  b, a
+  00100$:
+    ei
+    halt
+    di
+    ld  a, (_frameCount)
+    cp  a, b
+    jr  z, 00100$
+    ei
+    ret
+  __endasm;
 }
 
 void vdp_irq(void)
 {
+  frameCount++;
+
+  scan_input();
+
   if(vdp_callback) (*vdp_callback)();
 }
 
@@ -29,15 +86,36 @@ void spin_irq(void)
   if(spin_callback) (*spin_callback)();
 }
 
+#if ISR_MODE != ISR_GENERIC
+// write isrTarget into the hook jump in one instruction.
+static void patchVdpVector(void) __naked
+{
+  __asm
+    ld  hl, (_isrTarget)
+    ld  (_vdp_vector + 1), hl
+    ret
+  __endasm;
+}
+#endif
+
 void set_vdp_irq_callback(void (*callback)(void))
 {
   di();
 
+#if ISR_MODE == ISR_GENERIC
   vdp_callback = callback;
+#else
+  // the bios saved every register, hook the callback straight in, null goes
+  // back to the generic entry so frames and joysticks still update.
+  isrTarget = (callback ? (uint16_t)callback : (uint16_t)irq_timi);
+
+  patchVdpVector();
+#endif
 
   ei();
 }
 
+// the bios owns 0x38, spin_irq is not wired on msx.
 void set_spin_irq_callback(void (*callback)(void))
 {
   di();
@@ -46,3 +124,42 @@ void set_spin_irq_callback(void (*callback)(void))
 
   ei();
 }
+
+// read controller one, cached at the last vblank.
+uint16_t getControllerOne()
+{
+  uint16_t temp = 0;
+
+  di();
+
+  temp = controllerOne;
+
+  ei();
+
+  return temp;
+}
+
+// read controller two, cached at the last vblank.
+uint16_t getControllerTwo()
+{
+  uint16_t temp = 0;
+
+  di();
+
+  temp = controllerTwo;
+
+  ei();
+
+  return temp;
+}
+
+void scan_input(void)
+{
+  controllerOne = readJoystick(0);
+
+  controllerTwo = readJoystick(PSG_JOY_TWO);
+
+  updateInput(0, controllerOne);
+
+  updateInput(1, controllerTwo);
+}
@@ -6,9 +6,12 @@
 
    .module crt0
    .globl _main
+   .globl _stack_fill
    .globl _vdp_irq
    .globl _spin_irq
 
+   _vdp_vector == 0xFD9F
+
    .area _HEADER(ABS)
    .org 0x4000
 
@@ -19,23 +22,34 @@
 _init:
    ;; Set stack pointer directly above top of memory.
    ld	sp, #0xf000 ;; taken from libcv/src/crt0.s
+   call _stack_fill
 
    ;; Initialise global variables
    call  gsinit
+
+   ;; bios irq at 0x38 calls the H.TIMI hook each vblank, point it at the vdp irq
+   di
+   ld a, #0xC3
+   ld (_vdp_vector), a
+   ld hl, #_irq_timi
+   ld (_vdp_vector + 1), hl
+   ei
+
    call  _main
    rst   0x0
 
    ;; copied from sdcc src/z80/crt0.s
    .area _CODE
-   .area _INITIALIZER
    .area _HOME
    .area _GSINIT
    .area _GSFINAL
+   .area _INITIALIZER
    .area _DATA
    .area _INITIALIZED
    .area _BSEG
    .area _BSS
    .area _HEAP
+_heap_start::
    .area _CODE
 
 _irq_nmi:
@@ -52,6 +66,13 @@ _irq_nmi:
    pop af
    retn
 
+_irq_timi::
+   ;; bios saved the other registers, a holds the vdp status
+   push af
+   call _vdp_irq
+   pop af
+   ret
+
 _irq_spin:
    push af
    push bc
@@ -66,16 +87,103 @@ _irq_spin:
    pop af
    reti
 
+   ;; zero a block, hl start and bc length, 8 stores a pass
+gsinit_zero:
+   ld a, c
+   and a, #0x07
+   ld e, a
+   srl b
+   rr c
+   srl b
+   rr c
+   srl b
+   rr c
+   xor a, a
+   ld d, a
+   ld a, b
+   or a, c
+   jr Z, gsinit_zero_tail
+gsinit_zero_block:
+   ld (hl), d
+   inc hl
+   ld (hl), d
+   inc hl
+   ld (hl), d
+   inc hl
+   ld (hl), d
+   inc hl
+   ld (hl), d
+   inc hl
+   ld (hl), d
+   inc hl
+   ld (hl), d
+   inc hl
+   ld (hl), d
+   inc hl
+   dec bc
+   ld a, b
+   or a, c
+   jr NZ, gsinit_zero_block
+gsinit_zero_tail:
+   ld a, e
+   or a, a
+   ret Z
+   ld b, e
+gsinit_zero_byte:
+   ld (hl), d
+   inc hl
+   djnz gsinit_zero_byte
+   ret
+
+   ;; set to 1 by py/initpack.py when it packed the initializer
+_init_packed::
+   .db 0
+
 ;; copied from sdcc src/z80/crt0.s
    .area   _GSINIT
 gsinit::
+   ;; variables without an initializer start at zero
+   ld hl, #s__DATA
+   ld bc, #l__DATA
+   call gsinit_zero
+   ld hl, #s__BSS
+   ld bc, #l__BSS
+   call gsinit_zero
+
    ld bc, #l__INITIALIZER
    ld a, b
    or a, c
    jr Z, gsinit_next
    ld de, #s__INITIALIZED
    ld hl, #s__INITIALIZER
+   ld a, (_init_packed)
+   or a, a
+   jr NZ, gsinit_unpack
+   ldir
+   jr gsinit_next
+
+   ;; packed runs, 0 ends, 1 to 127 literal bytes follow, 128 to 255 is
+   ;; the next byte repeated 2 to 129 times
+gsinit_unpack:
+   ld a, (hl)
+   inc hl
+   or a, a
+   jr Z, gsinit_next
+   jp M, gsinit_run
+   ld c, a
+   ld b, #0
    ldir
+   jr gsinit_unpack
+gsinit_run:
+   sub a, #126
+   ld b, a
+   ld a, (hl)
+   inc hl
+gsinit_fill:
+   ld (de), a
+   inc de
+   djnz gsinit_fill
+   jr gsinit_unpack
 gsinit_next:
 
    .area   _GSFINAL
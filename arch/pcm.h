@@ -0,0 +1,80 @@
+/**************************************************************************//**
+ * @file    pcm.h
+ * @author  Jay Convertino
+ * @brief   Cycle counted sample loops shared by the sn76489 and gisnd pcm
+ *          drivers. A loop ors each 4 bit level with a latch and writes it
+ *          to one sound port, so the drivers only differ in the port and
+ *          latch they pass. Built into base.lib as its own object, only
+ *          linked when a pcm driver is used.
+ ******************************************************************************/
+
+#ifndef __PCM
+#define __PCM
+
+#include <base.h>
+#include <stdint.h>
+
+/** DEFINES **/
+/**
+ * @def PCM_HEADER
+ * bytes before the sample data.
+ */
+#define PCM_HEADER 4
+/**
+ * @def PCM_PACKED
+ * format, two 4 bit levels a byte.
+ */
+#define PCM_PACKED 0
+/**
+ * @def PCM_DELTA
+ * format, four 2 bit level deltas a byte.
+ */
+#define PCM_DELTA 1
+/**
+ * @def PCM_4KHZ
+ * rate, about 4000 samples a second.
+ */
+#define PCM_4KHZ 0
+/**
+ * @def PCM_8KHZ
+ * rate, about 8000 samples a second.
+ */
+#define PCM_8KHZ 1
+/**
+ * @def PCM_INVALID
+ * setPCMsample return for a header with an unknown format or rate.
+ */
+#define PCM_INVALID 0xFF
+
+/** DELTA TABLE **/
+/**
+ * @var c_pcmDelta
+ * next level for level * 4 + delta code.
+ */
+extern const uint8_t c_pcmDelta[];
+
+/***************************************************************************//**
+ * @brief   Load a sample and the vram data to step with it for playPCM.
+ *
+ * @param   p_sample sample with header, see the pcm driver headers.
+ * @param   p_vram bytes to write to vram during playback, one a sample, 0
+ *          for none.
+ * @param   vramSize number of bytes in p_vram.
+ *
+ * @return  start level of the sample, PCM_INVALID if the header is bad.
+ ******************************************************************************/
+uint8_t setPCMsample(uint8_t const * const p_sample, uint8_t const * const p_vram, uint16_t vramSize);
+
+/***************************************************************************//**
+ * @brief   Play the loaded sample, each level or latch goes out on port.
+ *          Call under vdp_lock with the irq off and the chip set up to take
+ *          raw levels, the lock holds the vdp nmi off the alternate
+ *          registers and the vram address. Uses the alternate registers and
+ *          ix, vdpAddr is moved past the vram bytes streamed.
+ *
+ * @param   port sound chip port the levels are written to.
+ * @param   latch bits or'ed into every level, 0 for none.
+ ******************************************************************************/
+void playPCM(uint8_t port, uint8_t latch);
+
+#endif
@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+################################################################################
+# @file   initpack.py
+# @author Jay Convertino(jayconvertino@outlook.com)
+# @date   2026.10.19
+# @brief  Pack the _INITIALIZER image of a linked ihx for the crt0 unpacker.
+#
+# @license MIT
+# Copyright 2026 Jay Convertino
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to
+# deal in the Software without restriction, including without limitation the
+# rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+# sell copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+################################################################################
+import argparse
+import sys
+import re
+
+# run is 128 + count - 2, literals are count then the bytes
+RUN_MIN = 3
+RUN_MAX = 129
+LIT_MAX = 127
+
+def main():
+  args = parse_args(sys.argv[1:])
+
+  try:
+    symbols       = read_symbols(args.map)
+    memory, start = read_ihx(args.ihx)
+  except (FileNotFoundError, ValueError) as e:
+    print(str(e))
+    exit(1)
+
+  for name in ["s__INITIALIZER", "l__INITIALIZER", "_init_packed"]:
+    if name not in symbols:
+      print("NO " + name + " IN " + args.map)
+      exit(1)
+
+  begin  = symbols["s__INITIALIZER"]
+  length = symbols["l__INITIALIZER"]
+  flag   = symbols["_init_packed"]
+
+  if memory.get(flag, 0):
+    print("INITIALIZER ALREADY PACKED")
+    return
+
+  if not length:
+    print("NO INITIALIZER TO PACK")
+    return
+
+  image  = bytes(memory.get(begin + index, 0) for index in range(length))
+  packed = pack(image)
+
+  if len(packed) >= length:
+    print(f"INITIALIZER {length} BYTES, PACKED {len(packed)} BYTES, LEFT UNPACKED")
+    return
+
+  # packed image over the start, the rest of the area is dropped from the rom
+  for index in range(length):
+    if index < len(packed):
+      memory[begin + index] = packed[index]
+    else:
+      memory.pop(begin + index, None)
+
+  memory[flag] = 1
+
+  write_ihx(args.ihx, memory, start)
+
+  print(f"INITIALIZER {length} BYTES, PACKED {len(packed)} BYTES, {length - len(packed)} BYTES OF ROM SAVED")
+
+# runs of 3 or more repeat bytes, everything else as literals, 0 ends.
+def pack(image):
+  packed  = bytearray()
+  literal = bytearray()
+  index   = 0
+
+  while index < len(image):
+    run = 1
+
+    while (index + run < len(image)) and (run < RUN_MAX) and (image[index + run] == image[index]):
+      run += 1
+
+    if run >= RUN_MIN:
+      flush_literal(packed, literal)
+
+      packed += bytes([128 + run - 2, image[index]])
+
+      index += run
+
+      continue
+
+    literal.append(image[index])
+
+    if len(literal) == LIT_MAX:
+      flush_literal(packed, literal)
+
+    index += 1
+
+  flush_literal(packed, literal)
+
+  packed.append(0)
+
+  return packed
+
+# literal count and bytes, then empty the literal buffer
+def flush_literal(packed, literal):
+  if not literal:
+    return
+
+  packed.append(len(literal))
+
+  packed += literal
+
+  literal.clear()
+
+# symbol values from a sdld map, or a noi file.
+def read_symbols(path):
+  symbols = {}
+
+  with open(path, 'r') as file:
+    for line in file:
+      match = re.search(r"DEF\s+([.\w]+)\s+0x([0-9A-Fa-f]+)", line)
+
+      if match:
+        symbols[match.group(1)] = int(match.group(2), 16)
+
+        continue
+
+      match = re.search(r"^\s*([0-9A-Fa-f]{4,8})\s+([.\w]+)", line)
+
+      if match:
+        symbols[match.group(2)] = int(match.group(1), 16)
+
+  return symbols
+
+# full address to byte for every data record, extended segment (02) and
+# linear (04) records set the upper address, start records (03, 05) are kept.
+def read_ihx(path):
+  memory = {}
+  start  = []
+  base   = 0
+
+  with open(path, 'r') as file:
+    for line in file:
+      line = line.strip()
+
+      if not line.startswith(':'):
+        continue
+
+      record = bytes.fromhex(line[1:])
+
+      if (len(record) < 5) or (len(record) != record[0] + 5) or (sum(record) & 0xFF):
+        raise ValueError("BAD RECORD IN " + path + ": " + line)
+
+      kind = record[3]
+
+      if kind == 0:
+        address = base + ((record[1] << 8) | record[2])
+
+        for index in range(record[0]):
+          memory[address + index] = record[4 + index]
+      elif kind == 1:
+        break
+      elif kind == 2:
+        base = ((record[4] << 8) | record[5]) << 4
+      elif kind == 4:
+        base = ((record[4] << 8) | record[5]) << 16
+      elif kind in (3, 5):
+        start.append(record)
+      else:
+        raise ValueError(f"UNKNOWN RECORD TYPE {kind:02X} IN " + path)
+
+  return memory, start
+
+# one record as text with its checksum
+def ihx_record(record):
+  return ":" + (record + bytes([(-sum(record)) & 0xFF])).hex().upper()
+
+# 16 byte records of the contiguous runs, a linear address record when the
+# upper address changes, then the start records and the end record.
+def write_ihx(path, memory, start):
+  addresses = sorted(memory)
+  records   = []
+  upper     = 0
+  index     = 0
+
+  while index < len(addresses):
+    address = addresses[index]
+    data    = bytearray()
+
+    if (address >> 16) != upper:
+      upper = address >> 16
+
+      records.append(ihx_record(bytes([2, 0, 0, 4, upper >> 8, upper & 0xFF])))
+
+    while (index < len(addresses)) and (addresses[index] == address + len(data)) and (len(data) < 16) and ((address + len(data)) >> 16 == upper):
+      data.append(memory[addresses[index]])
+
+      index += 1
+
+    records.append(ihx_record(bytes([len(data), (address >> 8) & 0xFF, address & 0xFF, 0]) + data))
+
+  for record in start:
+    records.append(ihx_record(record[:-1]))
+
+  records.append(":00000001FF")
+
+  with open(path, 'w') as file:
+    file.write("\n".join(records) + "\n")
+
+# parse args for tuning build
+def parse_args(argv):
+  parser = argparse.ArgumentParser(description='Pack the initializer of a linked ihx, crt0 unpacks it at boot.')
+
+  parser.add_argument('--ihx', action='store', default="main.ihx", dest='ihx', required=False, help='Linked ihx, packed in place.')
+  parser.add_argument('--map', action='store', default="main.map", dest='map', required=False, help='Map or noi file from the link.')
+
+  return parser.parse_args()
+
+# name is main is main
+if __name__=="__main__":
+  main()
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+################################################################################
+# @file   ramreport.py
+# @author Jay Convertino(jayconvertino@outlook.com)
+# @date   2026.10.19
+# @brief  Report RAM left for the heap and stack from a linked map file.
+#
+# @license MIT
+# Copyright 2026 Jay Convertino
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to
+# deal in the Software without restriction, including without limitation the
+# rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+# sell copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+################################################################################
+import argparse
+import sys
+import re
+
+def main():
+  args = parse_args(sys.argv[1:])
+
+  try:
+    symbols   = read_symbols(args.map)
+    stack_top = read_stack_top(args.defines)
+  except FileNotFoundError as e:
+    print(str(e))
+    exit(1)
+
+  if stack_top is None:
+    print("NO STACK_TOP IN " + args.defines)
+    exit(1)
+
+  if "s__HEAP" not in symbols:
+    print("NO s__HEAP IN " + args.map)
+    exit(1)
+
+  ram_start = int(args.dataloc, 0)
+  ram_end   = stack_top
+  heap      = symbols["s__HEAP"]
+  used      = heap - ram_start
+  left      = ram_end - heap
+
+  print(f"RAM 0x{ram_start:04X}-0x{ram_end-1:04X}, {used} BYTES OF VARIABLES, {left} BYTES LEFT FOR HEAP AND STACK")
+
+  if left < args.stack:
+    print(f"WARNING, LESS THAN {args.stack} BYTES LEFT FOR THE STACK")
+
+# symbol values from a sdld map, or a noi file, hex on either side of the name.
+def read_symbols(path):
+  symbols = {}
+
+  with open(path, 'r') as file:
+    for line in file:
+      match = re.search(r"DEF\s+(s__\w+)\s+0x([0-9A-Fa-f]+)", line)
+
+      if not match:
+        match = re.search(r"^\s*([0-9A-Fa-f]{4,8})\s+(s__\w+)", line)
+
+        if match:
+          symbols[match.group(2)] = int(match.group(1), 16)
+
+        continue
+
+      symbols[match.group(1)] = int(match.group(2), 16)
+
+  return symbols
+
+# stack pointer crt0 loads, STACK_TOP from the target defines.h.
+def read_stack_top(path):
+  with open(path, 'r') as file:
+    for line in file:
+      match = re.match(r"\s*#define\s+STACK_TOP\s+(0[xX][0-9A-Fa-f]+|\d+)", line)
+
+      if match:
+        return int(match.group(1), 0)
+
+  return None
+
+# parse args for tuning build
+def parse_args(argv):
+  parser = argparse.ArgumentParser(description='Report RAM left for the heap and stack after linking.')
+
+  parser.add_argument('--map',      action='store', default="main.map", dest='map',      required=False, help='Map or noi file from the link.')
+  parser.add_argument('--dataloc',  action='store', default="0x7000",   dest='dataloc',  required=False, help='DATALOC of the target.')
+  parser.add_argument('--defines',  action='store', default="defines.h", dest='defines',  required=False, help='Target defines.h with the STACK_TOP crt0 loads.')
+  parser.add_argument('--stack',    action='store', default=128,        dest='stack',    required=False, type=int, help='Warn when fewer bytes than this are left.')
+
+  return parser.parse_args()
+
+# name is main is main
+if __name__=="__main__":
+  main()
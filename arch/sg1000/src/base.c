@@ -9,31 +9,125 @@ volatile void (*vdp_callback)(void) = 0;
 
 volatile void (*spin_callback)(void) = 0;
 
-void __delay_us(int count)
+/* frames seen by vdp_irq, wait_vblank halts till it changes */
+volatile uint8_t frameCount = 0;
+
+#if ISR_MODE != ISR_GENERIC
+/* crt0 entries the vector jumps go back to, or through for shadow */
+void irq_vdp(void);
+
+void irq_vdp_shadow(void);
+
+void irq_nmi(void);
+
+void irq_nmi_shadow(void);
+
+/* address the patch helpers write */
+static uint16_t isrTarget = 0;
+#endif
+
+// halt till vdp_irq counts a frame, ei takes effect after the halt so the
+// irq can not land between the count check and the halt.
+void wait_vblank(void) __naked
+{
+  __asm
+    di
+    ld  a, (_frameCount)
+    ld  b, a
+  00100$:
+    ei
+    halt
+    di
+    ld  a, (_frameCount)
+    cp  a, b
+    jr  z, 00100$
+    ei
+    ret
+  __endasm;
+}
+
+void vdp_irq(void)
 {
-  for(; count > 0; count--)
+  frameCount++;
+
+  if(vdp_callback)
+  {
+    (*vdp_callback)();
+  }
+  else
   {
+    // nothing will read status, read it here to clear the vdp interrupt.
     __asm
-      nop
+      in  a, (_VDP_REG_PORT)
     __endasm;
   }
 }
 
-void vdp_irq(void)
+void spin_irq(void)
 {
-  if(vdp_callback) (*vdp_callback)();
+  if(spin_callback) (*spin_callback)();
 }
 
-void spin_irq(void)
+#if ISR_MODE != ISR_GENERIC
+// write isrTarget into a jump in one instruction, an nmi sees old or new.
+static void patchVdpVector(void) __naked
 {
-  if(spin_callback) (*spin_callback)();
+  __asm
+    ld  hl, (_isrTarget)
+    ld  (_vdp_vector + 1), hl
+    ret
+  __endasm;
 }
 
+static void patchVdpCall(void) __naked
+{
+  __asm
+    ld  hl, (_isrTarget)
+    ld  (_vdp_call + 1), hl
+    ret
+  __endasm;
+}
+
+static void patchSpinVector(void) __naked
+{
+  __asm
+    ld  hl, (_isrTarget)
+    ld  (_spin_vector + 1), hl
+    ret
+  __endasm;
+}
+
+static void patchSpinCall(void) __naked
+{
+  __asm
+    ld  hl, (_isrTarget)
+    ld  (_spin_call + 1), hl
+    ret
+  __endasm;
+}
+#endif
+
 void set_vdp_irq_callback(void (*callback)(void))
 {
   di();
 
+#if ISR_MODE == ISR_GENERIC
   vdp_callback = callback;
+#else
+  // null goes back to the generic entry so frames still count.
+  isrTarget = (callback ? (uint16_t)callback : (uint16_t)irq_vdp);
+
+#if ISR_MODE == ISR_SHADOW
+  if(callback)
+  {
+    patchVdpCall();
+
+    isrTarget = (uint16_t)irq_vdp_shadow;
+  }
+#endif
+
+  patchVdpVector();
+#endif
 
   ei();
 }
@@ -42,7 +136,22 @@ void set_spin_irq_callback(void (*callback)(void))
 {
   di();
 
+#if ISR_MODE == ISR_GENERIC
   spin_callback = callback;
+#else
+  isrTarget = (callback ? (uint16_t)callback : (uint16_t)irq_nmi);
+
+#if ISR_MODE == ISR_SHADOW
+  if(callback)
+  {
+    patchSpinCall();
+
+    isrTarget = (uint16_t)irq_nmi_shadow;
+  }
+#endif
+
+  patchSpinVector();
+#endif
 
   ei();
 }
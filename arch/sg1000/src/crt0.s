@@ -6,8 +6,13 @@
 
    .module crt0
    .globl _main
+   .globl _stack_fill
    .globl _vdp_irq
    .globl _spin_irq
+   .globl _vdp_vector
+   .globl _spin_vector
+   .globl _vdp_call
+   .globl _spin_call
 
    .area _HEADER(ABS)
    .org 0x0000
@@ -15,17 +20,31 @@
    im 1
    jp _init
 
+   ;; vdp interrupt is the maskable int on the sg1000
    .org 0x0038
-   jp _irq_spin
+   jp _vdp_vector
 
+   ;; nmi is the pause button, passed on through the spin callback
    .org 0x0066
-   jp _irq_nmi
+   jp _spin_vector
 
 
    .org 0x0080
 _init:
+   ;; irq vectors jump through ram so the callback setters can patch them
+   ld a, #0xC3
+   ld (_vdp_vector), a
+   ld (_spin_vector), a
+   ld (_vdp_call), a
+   ld (_spin_call), a
+   ld hl, #_irq_vdp
+   ld (_vdp_vector + 1), hl
+   ld hl, #_irq_nmi
+   ld (_spin_vector + 1), hl
+
    ;; Set stack pointer directly above top of memory.
    ld	sp, #0xC3FF
+   call _stack_fill
 
    ;; Initialise global variables
    call  gsinit
@@ -34,24 +53,39 @@ _init:
 
    ;; copied from sdcc src/z80/crt0.s
    .area _CODE
-   .area _INITIALIZER
    .area _HOME
    .area _GSINIT
    .area _GSFINAL
+   .area _INITIALIZER
    .area _DATA
+   .area _VECTORS
    .area _INITIALIZED
    .area _BSEG
    .area _BSS
    .area _HEAP
+_heap_start::
+
+   ;; jp opcode and address, patched by the callback setters, kept out of
+   ;; _DATA so gsinit does not clear them
+   .area _VECTORS
+_vdp_vector:
+   .ds 3
+_spin_vector:
+   .ds 3
+_vdp_call:
+   .ds 3
+_spin_call:
+   .ds 3
+
    .area _CODE
 
-_irq_nmi:
+_irq_nmi::
    push af
    push bc
    push de
    push hl
    push iy
-   call _vdp_irq
+   call _spin_irq
    pop iy
    pop hl
    pop de
@@ -59,30 +93,140 @@ _irq_nmi:
    pop af
    retn
 
-_irq_spin:
+_irq_vdp::
    push af
    push bc
    push de
    push hl
    push iy
-   call _spin_irq
+   call _vdp_irq
    pop iy
    pop hl
    pop de
    pop bc
    pop af
+   ei
    reti
 
+   ;; lean entry for handlers that only need the shadow registers
+_irq_vdp_shadow::
+   ex af, af'
+   exx
+   push iy
+   call _vdp_call
+   pop iy
+   exx
+   ex af, af'
+   ei
+   reti
+
+_irq_nmi_shadow::
+   ex af, af'
+   exx
+   push iy
+   call _spin_call
+   pop iy
+   exx
+   ex af, af'
+   retn
+
+   ;; zero a block, hl start and bc length, 8 stores a pass
+gsinit_zero:
+   ld a, c
+   and a, #0x07
+   ld e, a
+   srl b
+   rr c
+   srl b
+   rr c
+   srl b
+   rr c
+   xor a, a
+   ld d, a
+   ld a, b
+   or a, c
+   jr Z, gsinit_zero_tail
+gsinit_zero_block:
+   ld (hl), d
+   inc hl
+   ld (hl), d
+   inc hl
+   ld (hl), d
+   inc hl
+   ld (hl), d
+   inc hl
+   ld (hl), d
+   inc hl
+   ld (hl), d
+   inc hl
+   ld (hl), d
+   inc hl
+   ld (hl), d
+   inc hl
+   dec bc
+   ld a, b
+   or a, c
+   jr NZ, gsinit_zero_block
+gsinit_zero_tail:
+   ld a, e
+   or a, a
+   ret Z
+   ld b, e
+gsinit_zero_byte:
+   ld (hl), d
+   inc hl
+   djnz gsinit_zero_byte
+   ret
+
+   ;; set to 1 by py/initpack.py when it packed the initializer
+_init_packed::
+   .db 0
+
 ;; copied from sdcc src/z80/crt0.s
    .area   _GSINIT
 gsinit::
+   ;; variables without an initializer start at zero
+   ld hl, #s__DATA
+   ld bc, #l__DATA
+   call gsinit_zero
+   ld hl, #s__BSS
+   ld bc, #l__BSS
+   call gsinit_zero
+
    ld bc, #l__INITIALIZER
    ld a, b
    or a, c
    jr Z, gsinit_next
    ld de, #s__INITIALIZED
    ld hl, #s__INITIALIZER
+   ld a, (_init_packed)
+   or a, a
+   jr NZ, gsinit_unpack
+   ldir
+   jr gsinit_next
+
+   ;; packed runs, 0 ends, 1 to 127 literal bytes follow, 128 to 255 is
+   ;; the next byte repeated 2 to 129 times
+gsinit_unpack:
+   ld a, (hl)
+   inc hl
+   or a, a
+   jr Z, gsinit_next
+   jp M, gsinit_run
+   ld c, a
+   ld b, #0
    ldir
+   jr gsinit_unpack
+gsinit_run:
+   sub a, #126
+   ld b, a
+   ld a, (hl)
+   inc hl
+gsinit_fill:
+   ld (de), a
+   inc de
+   djnz gsinit_fill
+   jr gsinit_unpack
 gsinit_next:
 
    .area   _GSFINAL
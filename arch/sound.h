@@ -0,0 +1,120 @@
+/**************************************************************************//**
+ * @file    sound.h
+ * @author  Jay Convertino
+ * @brief   Portable sound calls for every target, channel, pitch, volume, and
+ *          noise. Each call is a macro that picks the sound chip driver for
+ *          SYS_DEFINE at compile time, there is no runtime dispatch. Coleco
+ *          and sg1000 use the sn76489, msx uses the gisnd, and coleco_sgm
+ *          drives both as six tone channels, 0 to 2 sn76489, 3 to 5 gisnd.
+ *          Channel arguments are evaluated more than once on coleco_sgm.
+ ******************************************************************************/
+
+#ifndef __SOUND
+#define __SOUND
+
+#include <base.h>
+#include <stdint.h>
+
+#if defined(_COLECO) || defined(_COLECO_SGM) || defined(_SG1000)
+#include <sn76489.h>
+#endif
+
+#if defined(_COLECO_SGM) || defined(_MSX)
+#include <gisnd.h>
+#endif
+
+/** DEFINES **/
+/**
+ * @def SND_VOLUME_MAX
+ * loudest volume, 0 is silent.
+ */
+#define SND_VOLUME_MAX 15
+/**
+ * @def SND_NOTE
+ * note from octave 1 to 8 and semitone 0 (C) to 11 (B), 0 is C1.
+ */
+#define SND_NOTE(octave, semitone) ((uint8_t)(((octave) - 1) * 12 + (semitone)))
+/**
+ * @def SND_PITCH
+ * pitch from a note and a 1/16 semitone fine tune, same for both drivers.
+ */
+#define SND_PITCH(note, fine) ((uint16_t)(((uint16_t)(note) << 4) | ((fine) & 0x0F)))
+
+/** METHODS **/
+/**
+ * @def initSound
+ * mute every channel, the gisnd mixer is set to tones only.
+ */
+/**
+ * @def setSoundDefer
+ * hold writes until commitSound, 0 writes on every set again.
+ */
+/**
+ * @def commitSound
+ * write held changes, one interrupt disable per chip.
+ */
+/**
+ * @def setSoundDiv
+ * set a channel tone divider, f = 111861 / div on every target.
+ */
+/**
+ * @def setSoundPitch
+ * set a channel to a SND_PITCH from the note tables.
+ */
+/**
+ * @def setSoundVolume
+ * set a channel volume, 0 silent to SND_VOLUME_MAX.
+ */
+/**
+ * @def setSoundNoise
+ * white noise, period 0 is highest, 1 and 2 lower, 3 follows channel 2 on
+ * the sn76489, the gisnd uses its lowest rate for 1 to 3. Volume 0 is off.
+ */
+
+#if defined(_COLECO_SGM)
+/**
+ * @def SND_SN_CHANNELS
+ * channels before the gisnd channels start.
+ */
+#define SND_SN_CHANNELS 3
+/**
+ * @def SND_CHANNELS
+ * tone channels on this target.
+ */
+#define SND_CHANNELS 6
+
+/*** both chips, noise is the sn76489 noise channel ***/
+#define initSound() (initSN76489(), initGISND(), setGISNDmixer(0x07, 0x00))
+#define setSoundDefer(defer) (setSN76489defer(defer), setGISNDdefer(defer))
+#define commitSound() (commitSN76489(), commitGISND())
+#define setSoundDiv(channel, div) ((channel) < SND_SN_CHANNELS ? setSN76489voice_freq((channel) + 1, div) : setGISNDchannel_freq('A' + (channel) - SND_SN_CHANNELS, div))
+#define setSoundPitch(channel, pitch) ((channel) < SND_SN_CHANNELS ? setSN76489voice_pitch((channel) + 1, pitch) : setGISNDchannel_pitch('A' + (channel) - SND_SN_CHANNELS, pitch))
+#define setSoundVolume(channel, volume) ((channel) < SND_SN_CHANNELS ? setSN76489voice_attn((channel) + 1, SND_VOLUME_MAX - (volume)) : setGISNDchannel_attn('A' + (channel) - SND_SN_CHANNELS, volume, 0))
+#define setSoundNoise(period, volume) (setSN76489noiseCtrl(1, period), setSN76489noise_attn(SND_VOLUME_MAX - (volume)))
+
+#elif defined(_MSX)
+#define SND_CHANNELS 3
+
+/*** noise is mixed into the last channel and sets its volume ***/
+#define initSound() (initGISND(), setGISNDmixer(0x07, 0x00))
+#define setSoundDefer(defer) setGISNDdefer(defer)
+#define commitSound() commitGISND()
+#define setSoundDiv(channel, div) setGISNDchannel_freq('A' + (channel), div)
+#define setSoundPitch(channel, pitch) setGISNDchannel_pitch('A' + (channel), pitch)
+#define setSoundVolume(channel, volume) setGISNDchannel_attn('A' + (channel), volume, 0)
+#define setSoundNoise(period, volume) (setGISNDnoise_freq((period) ? 0x1F : 0x10), setGISNDchannel_attn('C', volume, 0), setGISNDmixer(((volume) ? 0x03 : 0x07), 0x00))
+
+#else
+#define SND_CHANNELS 3
+
+/*** sn76489 only ***/
+#define initSound() initSN76489()
+#define setSoundDefer(defer) setSN76489defer(defer)
+#define commitSound() commitSN76489()
+#define setSoundDiv(channel, div) setSN76489voice_freq((channel) + 1, div)
+#define setSoundPitch(channel, pitch) setSN76489voice_pitch((channel) + 1, pitch)
+#define setSoundVolume(channel, volume) setSN76489voice_attn((channel) + 1, SND_VOLUME_MAX - (volume))
+#define setSoundNoise(period, volume) (setSN76489noiseCtrl(1, period), setSN76489noise_attn(SND_VOLUME_MAX - (volume)))
+#endif
+
+#endif
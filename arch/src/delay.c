@@ -0,0 +1,75 @@
+/**************************************************************************//**
+ * @file    delay.c
+ * @author  Jay Convertino
+ ******************************************************************************/
+
+#include "base.h"
+
+/* delay loop length and the cost of the wrapper and call around it */
+#define DELAY_T_LOOP  32
+#define DELAY_T_CALL  192
+#define DELAY_US_LOOP 16
+#define DELAY_US_CALL 48
+
+#if ((CPU_CLK * DELAY_US_LOOP + 500000) / 1000000) != 57
+#error "__delay_us loop is 57 T-states, 16 us at a CPU_CLK of 3579545"
+#endif
+
+/* loop count for the naked delay loops, set by the c wrappers */
+static uint16_t delayLoops = 0;
+
+// 32 T-states a loop, count in delayLoops.
+static void delayLoop32(void) __naked
+{
+  __asm
+    ld  bc, (_delayLoops)
+  00100$:
+    dec bc
+    nop
+    nop
+    ld  a, b
+    or  a, c
+    jp  nz, 00100$
+    ret
+  __endasm;
+}
+
+// 57 T-states a loop, 16 us at CPU_CLK, count in delayLoops.
+static void delayLoop57(void) __naked
+{
+  __asm
+    ld  bc, (_delayLoops)
+  00100$:
+    dec bc
+    nop
+    nop
+    nop
+    ld  a, (hl)
+    ld  a, (hl)
+    ld  a, (hl)
+    ld  a, b
+    or  a, c
+    jp  nz, 00100$
+    ret
+  __endasm;
+}
+
+// delay at least tstates, in steps of one 32 T-state loop.
+void __delay_tstates(uint16_t tstates)
+{
+  if(tstates < DELAY_T_CALL + DELAY_T_LOOP) return;
+
+  delayLoops = (tstates - DELAY_T_CALL) >> 5;
+
+  delayLoop32();
+}
+
+// delay count microseconds, in steps of one 16 us loop.
+void __delay_us(uint16_t count)
+{
+  if(count < DELAY_US_CALL + DELAY_US_LOOP) return;
+
+  delayLoops = (count - DELAY_US_CALL) >> 4;
+
+  delayLoop57();
+}
@@ -0,0 +1,164 @@
+/**************************************************************************//**
+ * @file    frame.c
+ * @author  Jay Convertino
+ ******************************************************************************/
+
+#include "base.h"
+
+/* frame scheduler tasks and timing, idle counts are 128 T-state passes */
+static void (*frameTask[FRAME_PHASES][FRAME_SLOTS])(void) = {{0}};
+
+static struct s_frameStats frameStats = {0};
+
+static uint8_t frameRun = 0;
+
+static uint8_t frameMeasure = 0;
+
+static uint16_t idleCount = 0;
+
+static uint16_t idleMax = 0;
+
+// count 128 T-state passes in idleCount till vdp_irq counts a frame.
+static void idleFrame(void) __naked
+{
+  __asm
+    ld  hl, #0
+    ld  a, (_frameCount)
+    ld  c, a
+  00100$:
+    inc hl
+    ld  b, #7
+  00101$:
+    djnz 00101$
+    ld  a, (_frameCount)
+    cp  a, c
+    jr  z, 00100$
+    ld  (_idleCount), hl
+    ret
+  __endasm;
+}
+
+// run the tasks of a phase in slot order.
+static void runFrameTasks(uint8_t phase)
+{
+  uint8_t index = 0;
+
+  for(index = 0; index < FRAME_SLOTS; index++)
+  {
+    if(frameTask[phase][index]) (*frameTask[phase][index])();
+  }
+}
+
+// keep the used percent and its peak.
+static void setFrameUsed(uint8_t used)
+{
+  frameStats.used = used;
+
+  if(used > frameStats.peak) frameStats.peak = used;
+}
+
+void set_frame_task(uint8_t phase, uint8_t slot, void (*task)(void))
+{
+  if(phase >= FRAME_PHASES) return;
+
+  if(slot >= FRAME_SLOTS) return;
+
+  frameTask[phase][slot] = task;
+}
+
+void set_frame_measure(uint8_t measure)
+{
+  frameMeasure = 0;
+
+  if(!measure) return;
+
+  ei();
+
+  // first pass lines up with a frame, the second is a whole idle frame.
+  idleFrame();
+
+  idleFrame();
+
+  idleMax = idleCount;
+
+  frameStats.frames = 0;
+  frameStats.skipped = 0;
+  frameStats.used = 0;
+  frameStats.peak = 0;
+
+  frameMeasure = (idleMax != 0);
+}
+
+void get_frame_stats(struct s_frameStats * const p_stats)
+{
+  if(!p_stats) return;
+
+  *p_stats = frameStats;
+}
+
+void run_frames(void)
+{
+  uint8_t frame = 0;
+  uint8_t lastFrame = 0;
+  uint8_t elapsed = 0;
+  uint16_t idle = 0;
+
+  frameRun = 1;
+
+  ei();
+
+  lastFrame = frameCount;
+
+  while(frameRun)
+  {
+    frame = frameCount;
+
+    elapsed = frame - lastFrame;
+
+    // tasks finished inside the frame, wait for the next one.
+    if(!elapsed)
+    {
+      if(frameMeasure)
+      {
+        idleFrame();
+
+        idle = (idleCount < idleMax ? idleCount : idleMax);
+
+        // 128 T-state passes keep idleMax * 100 inside 16 bits at 50 or 60 Hz.
+        setFrameUsed((uint8_t)(((idleMax - idle) * 100) / idleMax));
+      }
+      else
+      {
+        wait_vblank();
+      }
+
+      continue;
+    }
+
+    // more than one frame passed, update to catch up and skip the renders.
+    if(elapsed > 1)
+    {
+      frameStats.skipped += elapsed - 1;
+
+      setFrameUsed(100);
+    }
+
+    lastFrame = frame;
+
+    if(elapsed > FRAME_SKIP_MAX) elapsed = FRAME_SKIP_MAX;
+
+    runFrameTasks(FRAME_RENDER);
+
+    for(; elapsed > 0; elapsed--)
+    {
+      runFrameTasks(FRAME_UPDATE);
+    }
+
+    frameStats.frames++;
+  }
+}
+
+void stop_frames(void)
+{
+  frameRun = 0;
+}
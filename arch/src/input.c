@@ -0,0 +1,98 @@
+/**************************************************************************//**
+ * @file    input.c
+ * @author  Jay Convertino
+ ******************************************************************************/
+
+#include "base.h"
+
+/* targets with joystick bits in defines.h, the keypad only where there is one */
+#ifdef UP_BIT
+
+/* input service, held and edges per controller, repeat counts down frames */
+static struct s_input input[INPUT_CONTROLLERS] = {{0, 0, 0, KEY_NONE}, {0, 0, 0, KEY_NONE}};
+
+static uint8_t inputRepeat[INPUT_CONTROLLERS] = {0};
+
+static uint8_t repeatDelay = 0;
+
+static uint8_t repeatRate = 0;
+
+#ifdef KEYPAD_MASK
+static uint8_t inputKeyRaw[INPUT_CONTROLLERS] = {KEYPAD_MASK, KEYPAD_MASK};
+
+/* keypad nibble to key, all lines high is no key */
+const uint8_t c_keypadDecode[16] = {
+  KEY_NONE, 8, 4, 5, KEY_NONE, 7, KEY_POUND, 2,
+  KEY_NONE, KEY_STAR, 0, 9, 3, 1, 6, KEY_NONE
+};
+#endif
+
+// edges and repeat for one controller from its raw active low read, called by scan_input.
+void updateInput(uint8_t controller, uint16_t raw)
+{
+#ifdef KEYPAD_MASK
+  uint8_t keyRaw = (uint8_t)((raw >> KEYPAD_BIT) & KEYPAD_MASK);
+#endif
+  uint16_t held = ~raw & INPUT_BUTTONS;
+  uint16_t change = 0;
+  struct s_input *p_input = &input[controller];
+
+#ifdef KEYPAD_MASK
+  // a key counts once it reads the same two frames, the keypad glitches while pressed.
+  if(keyRaw == inputKeyRaw[controller]) p_input->key = c_keypadDecode[keyRaw];
+
+  inputKeyRaw[controller] = keyRaw;
+
+  if(p_input->key != KEY_NONE) held |= INPUT_KEY;
+#endif
+
+  change = held ^ p_input->held;
+
+  p_input->pressed |= change & held;
+
+  p_input->released |= change & p_input->held;
+
+  p_input->held = held;
+
+  // new presses restart the repeat, held buttons show up in pressed again.
+  if(change & held)
+  {
+    inputRepeat[controller] = repeatDelay;
+  }
+  else if(held && repeatDelay && !--inputRepeat[controller])
+  {
+    p_input->pressed |= held;
+
+    inputRepeat[controller] = repeatRate;
+  }
+}
+
+void get_input(uint8_t controller, struct s_input * const p_input)
+{
+  if(!p_input) return;
+
+  if(controller >= INPUT_CONTROLLERS) return;
+
+  vdp_lock();
+
+  *p_input = input[controller];
+
+  input[controller].pressed = 0;
+
+  input[controller].released = 0;
+
+  vdp_unlock();
+}
+
+void set_input_repeat(uint8_t delay, uint8_t rate)
+{
+  vdp_lock();
+
+  repeatDelay = delay;
+
+  repeatRate = (rate ? rate : 1);
+
+  vdp_unlock();
+}
+
+#endif
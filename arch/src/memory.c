@@ -0,0 +1,155 @@
+/**************************************************************************//**
+ * @file    memory.c
+ * @author  Jay Convertino
+ ******************************************************************************/
+
+#include "base.h"
+
+/* start of the _HEAP area from crt0, and the stack pointer read for the heap arena */
+extern uint8_t heap_start[];
+
+static uint16_t stackPtr = 0;
+
+/* bottom of the stack region in stack.c, set to the end of the heap arena */
+extern uint16_t stackFloor;
+
+// stack pointer of the caller, for the heap arena.
+static void readStack(void) __naked
+{
+  __asm
+    ld  (_stackPtr), sp
+    ret
+  __endasm;
+}
+
+void init_pool(struct s_pool * const p_pool, void * const p_mem, uint8_t size, uint8_t blocks)
+{
+  uint8_t index = 0;
+  uint8_t *p_block = 0;
+
+  if(!p_pool) return;
+
+  p_pool->p_mem = (uint8_t *)p_mem;
+  p_pool->size = size;
+  p_pool->blocks = (blocks == POOL_NONE ? POOL_NONE - 1 : blocks);
+  p_pool->next = POOL_NONE;
+  p_pool->used = 0;
+
+  if(!p_mem || !size || !p_pool->blocks) return;
+
+  // each free block holds the index of the next one, the last holds none.
+  p_block = p_pool->p_mem;
+
+  for(index = 1; index < p_pool->blocks; index++)
+  {
+    *p_block = index;
+
+    p_block += size;
+  }
+
+  *p_block = POOL_NONE;
+
+  p_pool->next = 0;
+}
+
+uint8_t alloc_pool(struct s_pool * const p_pool)
+{
+  uint8_t index = 0;
+
+  if(!p_pool) return POOL_NONE;
+
+  index = p_pool->next;
+
+  if(index == POOL_NONE) return POOL_NONE;
+
+  p_pool->next = p_pool->p_mem[(uint16_t)index * p_pool->size];
+
+  p_pool->used++;
+
+  return index;
+}
+
+void free_pool(struct s_pool * const p_pool, uint8_t index)
+{
+  if(!p_pool) return;
+
+  if(index >= p_pool->blocks) return;
+
+  p_pool->p_mem[(uint16_t)index * p_pool->size] = p_pool->next;
+
+  p_pool->next = index;
+
+  p_pool->used--;
+}
+
+void *get_pool_block(struct s_pool * const p_pool, uint8_t index)
+{
+  if(!p_pool) return 0;
+
+  if(index >= p_pool->blocks) return 0;
+
+  return p_pool->p_mem + (uint16_t)index * p_pool->size;
+}
+
+void init_arena(struct s_arena * const p_arena, void * const p_mem, uint16_t size)
+{
+  if(!p_arena) return;
+
+  p_arena->p_mem = (uint8_t *)p_mem;
+
+  p_arena->size = (p_mem ? size : 0);
+
+  p_arena->top = 0;
+}
+
+uint16_t init_heap_arena(struct s_arena * const p_arena, uint16_t stackReserve)
+{
+  uint16_t start = (uint16_t)heap_start;
+  uint16_t size = 0;
+
+  readStack();
+
+  if(stackPtr > start + stackReserve) size = stackPtr - stackReserve - start;
+
+  init_arena(p_arena, heap_start, size);
+
+  stackFloor = start + size;
+
+  return size;
+}
+
+void *alloc_arena(struct s_arena * const p_arena, uint16_t size)
+{
+  uint8_t *p_mem = 0;
+
+  if(!p_arena) return 0;
+
+  if(size > p_arena->size - p_arena->top) return 0;
+
+  p_mem = p_arena->p_mem + p_arena->top;
+
+  p_arena->top += size;
+
+  return p_mem;
+}
+
+uint16_t get_arena_mark(struct s_arena * const p_arena)
+{
+  if(!p_arena) return 0;
+
+  return p_arena->top;
+}
+
+void set_arena_mark(struct s_arena * const p_arena, uint16_t mark)
+{
+  if(!p_arena) return;
+
+  if(mark < p_arena->top) p_arena->top = mark;
+}
+
+uint16_t get_arena_free(struct s_arena * const p_arena)
+{
+  if(!p_arena) return 0;
+
+  return p_arena->size - p_arena->top;
+}
@@ -0,0 +1,315 @@
+/**************************************************************************//**
+ * @file    pcm.c
+ * @author  Jay Convertino
+ ******************************************************************************/
+
+#include "pcm.h"
+
+#ifndef CPU_CLK
+#define CPU_CLK       3579545
+#endif
+#define PCM_FORMAT    0
+#define PCM_RATE      1
+#define PCM_SIZE_L    2
+#define PCM_SIZE_H    3
+#define PCM_FORMATS   2
+#define PCM_RATES     2
+#define STATE_LATCH   0
+#define STATE_LEVEL   1
+#define STATE_BITS    2
+#define STATE_DELAY   3
+#define STATE_PORT    4
+#define STATE_SIZE    5
+
+/* T-states of a sample period outside the delay loop */
+#define PACKED_T      186
+#define DELTA_T       393
+
+/* delay loop count for a rate, 13 T-states a count */
+#define PCM_DELAY(rate, fixed) (uint8_t)(((CPU_CLK / (rate)) - (fixed) + 6) / 13)
+
+/* per format and rate, folded by the compiler */
+static const uint8_t c_pcmDelay[PCM_FORMATS][PCM_RATES] =
+{
+  {PCM_DELAY(4000, PACKED_T), PCM_DELAY(8000, PACKED_T)},
+  {PCM_DELAY(4000, DELTA_T),  PCM_DELAY(8000, DELTA_T)}
+};
+
+/* next level for level * 4 + code, codes -2, -1, +1, +2 clamped */
+const uint8_t c_pcmDelta[64] =
+{
+  0, 0, 1, 2, 0, 0, 2, 3, 0, 1, 3, 4, 1, 2, 4, 5,
+  2, 3, 5, 6, 3, 4, 6, 7, 4, 5, 7, 8, 5, 6, 8, 9,
+  6, 7, 9, 10, 7, 8, 10, 11, 8, 9, 11, 12, 9, 10, 12, 13,
+  10, 11, 13, 14, 11, 12, 14, 15, 12, 13, 15, 15, 13, 14, 15, 15
+};
+
+/* latch, level, delta bits, delay, and port, indexed off ix in the loops */
+static uint8_t pcmState[STATE_SIZE];
+
+static uint8_t pcmFormat = 0;
+
+/* sample data and bytes left */
+static uint8_t const *p_pcmData = 0;
+
+static uint16_t pcmSize = 0;
+
+/* vram data and bytes left */
+static uint8_t const *p_pcmVram = 0;
+
+static uint16_t pcmVramSize = 0;
+
+static void playPCMpacked(void) __naked;
+
+static void playPCMdelta(void) __naked;
+
+uint8_t setPCMsample(uint8_t const * const p_sample, uint8_t const * const p_vram, uint16_t vramSize)
+{
+  uint8_t rate = 0;
+
+  if(!p_sample) return PCM_INVALID;
+
+  pcmFormat = p_sample[PCM_FORMAT] & 0x0F;
+
+  rate = p_sample[PCM_RATE];
+
+  if((pcmFormat >= PCM_FORMATS) || (rate >= PCM_RATES)) return PCM_INVALID;
+
+  pcmState[STATE_LEVEL] = p_sample[PCM_FORMAT] >> 4;
+
+  pcmState[STATE_DELAY] = c_pcmDelay[pcmFormat][rate];
+
+  p_pcmData = p_sample + PCM_HEADER;
+
+  pcmSize = (uint16_t)p_sample[PCM_SIZE_L] | ((uint16_t)p_sample[PCM_SIZE_H] << 8);
+
+  p_pcmVram = p_vram;
+
+  pcmVramSize = (p_vram ? vramSize : 0);
+
+  return pcmState[STATE_LEVEL];
+}
+
+void playPCM(uint8_t port, uint8_t latch)
+{
+  uint8_t per = (pcmFormat == PCM_DELTA ? 4 : 2);
+
+  uint16_t moved = pcmVramSize;
+
+  // one vram byte a sample until either runs out, the count moves vdpAddr.
+  if(pcmSize < (pcmVramSize / per) + ((pcmVramSize % per) ? 1 : 0))
+  {
+    moved = pcmSize * per;
+  }
+
+  pcmState[STATE_LATCH] = latch;
+
+  pcmState[STATE_PORT] = port;
+
+  if(pcmFormat == PCM_DELTA)
+  {
+    playPCMdelta();
+  }
+  else
+  {
+    playPCMpacked();
+  }
+
+  vdp_move(moved);
+}
+
+/* packed loop, each half of a byte pads to the same 186 + 13 * delay T-states */
+static void playPCMpacked(void) __naked
+{
+  __asm
+    push  ix
+    ld    ix, #_pcmState
+    exx
+    ld    hl, (_p_pcmVram)
+    ld    de, (_pcmVramSize)
+    ld    c, #_VDP_DATA_PORT
+    exx
+    ld    hl, (_p_pcmData)
+    ld    de, (_pcmSize)
+    ld    c, 4 (ix)
+    ld    a, d
+    or    a, e
+    jr    Z, 00104$
+00100$:
+    ld    a, (hl)
+    rrca
+    rrca
+    rrca
+    rrca
+    and   a, #0x0F
+    or    a, 0 (ix)
+    out   (c), a
+    call  00110$
+    ld    b, 3 (ix)
+00101$:
+    djnz  00101$
+    inc   hl
+    dec   hl
+    ld    a, d
+    or    a, e
+    jp    00102$
+00102$:
+    ld    a, (hl)
+    and   a, #0x0F
+    or    a, 0 (ix)
+    nop
+    nop
+    nop
+    nop
+    out   (c), a
+    call  00110$
+    ld    b, 3 (ix)
+00103$:
+    djnz  00103$
+    inc   hl
+    dec   de
+    ld    a, d
+    or    a, e
+    jp    NZ, 00100$
+00104$:
+    pop   ix
+    ret
+00110$:
+    exx
+    ld    a, d
+    or    a, e
+    jr    Z, 00111$
+    ld    a, (hl)
+    out   (c), a
+    inc   hl
+    dec   de
+    exx
+    ret
+00111$:
+    ld    a, (hl)
+    ld    a, (hl)
+    inc   hl
+    dec   hl
+    exx
+    ret
+  __endasm;
+}
+
+/* delta loop, four codes a byte, each slot pads to the same 393 + 13 * delay T-states */
+static void playPCMdelta(void) __naked
+{
+  __asm
+    push  ix
+    ld    ix, #_pcmState
+    exx
+    ld    hl, (_p_pcmVram)
+    ld    de, (_pcmVramSize)
+    ld    c, #_VDP_DATA_PORT
+    exx
+    ld    hl, (_p_pcmData)
+    ld    de, (_pcmSize)
+    ld    c, 4 (ix)
+    ld    a, d
+    or    a, e
+    jr    Z, 00128$
+00120$:
+    ld    a, (hl)
+    ld    2 (ix), a
+    call  00130$
+    out   (c), a
+    call  00140$
+    ld    b, 3 (ix)
+00121$:
+    djnz  00121$
+    inc   hl
+    dec   hl
+    ld    a, d
+    or    a, e
+    jp    00122$
+00122$:
+    ld    a, (hl)
+    ld    a, 2 (ix)
+    call  00130$
+    out   (c), a
+    call  00140$
+    ld    b, 3 (ix)
+00123$:
+    djnz  00123$
+    inc   hl
+    dec   hl
+    ld    a, d
+    or    a, e
+    jp    00124$
+00124$:
+    ld    a, (hl)
+    ld    a, 2 (ix)
+    call  00130$
+    out   (c), a
+    call  00140$
+    ld    b, 3 (ix)
+00125$:
+    djnz  00125$
+    inc   hl
+    dec   hl
+    ld    a, d
+    or    a, e
+    jp    00126$
+00126$:
+    ld    a, (hl)
+    ld    a, 2 (ix)
+    call  00130$
+    out   (c), a
+    call  00140$
+    ld    b, 3 (ix)
+00127$:
+    djnz  00127$
+    inc   hl
+    dec   de
+    ld    a, d
+    or    a, e
+    jp    NZ, 00120$
+00128$:
+    pop   ix
+    ret
+00130$:
+    ld    a, 1 (ix)
+    add   a, a
+    add   a, a
+    ld    b, a
+    rlc   2 (ix)
+    rlc   2 (ix)
+    ld    a, 2 (ix)
+    and   a, #0x03
+    or    a, b
+    push  hl
+    ld    hl, #_c_pcmDelta
+    add   a, l
+    ld    l, a
+    adc   a, h
+    sub   a, l
+    ld    h, a
+    ld    a, (hl)
+    pop   hl
+    ld    1 (ix), a
+    or    a, 0 (ix)
+    ret
+00140$:
+    exx
+    ld    a, d
+    or    a, e
+    jr    Z, 00141$
+    ld    a, (hl)
+    out   (c), a
+    inc   hl
+    dec   de
+    exx
+    ret
+00141$:
+    ld    a, (hl)
+    ld    a, (hl)
+    inc   hl
+    dec   hl
+    exx
+    ret
+  __endasm;
+}
@@ -0,0 +1,79 @@
+/**************************************************************************//**
+ * @file    stack.c
+ * @author  Jay Convertino
+ ******************************************************************************/
+
+#include "base.h"
+
+/* start of the _HEAP area from crt0, the stack region starts there by default */
+extern uint8_t heap_start[];
+
+/* bottom of the stack region for get_stack_stats, 0 is heap_start, init_heap_arena moves it */
+uint16_t stackFloor = 0;
+
+// fill heap_start up to the return address with the canary, the variables
+// are not set up yet so only constants are used.
+void stack_fill(void) __naked
+{
+#if STACK_CHECK
+  __asm
+    ld  hl, #0
+    add hl, sp
+    ld  de, #_heap_start
+    or  a, a
+    sbc hl, de
+    ret c
+    ret z
+    ld  b, h
+    ld  c, l
+    ld  h, d
+    ld  l, e
+    ld  (hl), #0xA5
+    dec bc
+    ld  a, b
+    or  a, c
+    ret z
+    inc de
+    ldir
+    ret
+  __endasm;
+#else
+  __asm
+    ret
+  __endasm;
+#endif
+}
+
+uint8_t get_stack_stats(struct s_stackStats * const p_stats)
+{
+#if STACK_CHECK
+  uint8_t *p_scan = (stackFloor ? (uint8_t *)stackFloor : heap_start);
+  uint16_t untouched = 0;
+
+  if(!p_stats) return 0;
+
+  p_stats->size = STACK_TOP - (uint16_t)p_scan;
+
+  // canary bytes left from the bottom up, the rest the stack has used.
+  while((untouched < p_stats->size) && (*p_scan == STACK_CANARY))
+  {
+    untouched++;
+
+    p_scan++;
+  }
+
+  p_stats->peak = p_stats->size - untouched;
+
+  p_stats->damaged = (untouched < STACK_GUARD);
+
+  return 1;
+#else
+  if(!p_stats) return 0;
+
+  p_stats->size = 0;
+  p_stats->peak = 0;
+  p_stats->damaged = 0;
+
+  return 0;
+#endif
+}
@@ -0,0 +1,146 @@
+/**************************************************************************//**
+ * @file    task.c
+ * @author  Jay Convertino
+ ******************************************************************************/
+
+#include "base.h"
+
+/* cooperative tasks, coSp is the stack the next swap moves to */
+static struct s_task *taskList[TASKS_MAX] = {0};
+
+static struct s_task *p_taskCurrent = 0;
+
+static uint16_t coSp = 0;
+
+// swap stacks with coSp, only ix and iy live across a call.
+static void coSwap(void) __naked
+{
+  __asm
+    push ix
+    push iy
+    ld  hl, #0
+    add hl, sp
+    ld  sp, (_coSp)
+    ld  (_coSp), hl
+    pop iy
+    pop ix
+    ret
+  __endasm;
+}
+
+// a task entry returns here, it is never resumed.
+static void taskExit(void)
+{
+  p_taskCurrent->state = TASK_DONE;
+
+  coSwap();
+}
+
+uint8_t start_task(struct s_task * const p_task, void (*entry)(void), uint8_t * const p_stack, uint16_t size)
+{
+  uint8_t index = 0;
+  uint16_t *p_sp = 0;
+
+  if(!p_task) return 0;
+
+  if(!entry) return 0;
+
+  if(!p_stack) return 0;
+
+  if(size < TASK_STACK_MIN) return 0;
+
+  for(index = 0; index < TASKS_MAX; index++)
+  {
+    if(!taskList[index]) break;
+  }
+
+  if(index == TASKS_MAX) return 0;
+
+  // first swap pops iy and ix, then returns into entry, and entry into taskExit.
+  p_sp = (uint16_t *)(p_stack + size);
+
+  *--p_sp = (uint16_t)taskExit;
+  *--p_sp = (uint16_t)entry;
+  *--p_sp = 0;
+  *--p_sp = 0;
+
+  p_task->sp = (uint16_t)p_sp;
+
+  p_task->wake = frameCount;
+
+  p_task->state = TASK_READY;
+
+  taskList[index] = p_task;
+
+  return 1;
+}
+
+void stop_task(struct s_task * const p_task)
+{
+  uint8_t index = 0;
+
+  if(!p_task) return;
+
+  if(p_task == p_taskCurrent) return;
+
+  for(index = 0; index < TASKS_MAX; index++)
+  {
+    if(taskList[index] == p_task) taskList[index] = 0;
+  }
+
+  p_task->state = TASK_DONE;
+}
+
+uint8_t get_task_busy(struct s_task * const p_task)
+{
+  if(!p_task) return 0;
+
+  return p_task->state != TASK_DONE;
+}
+
+void run_tasks(void)
+{
+  uint8_t index = 0;
+  struct s_task *p_task = 0;
+
+  // a task calling run_tasks would swap onto itself.
+  if(p_taskCurrent) return;
+
+  for(index = 0; index < TASKS_MAX; index++)
+  {
+    p_task = taskList[index];
+
+    if(!p_task) continue;
+
+    // signed so a wake frame in the past is ready after the count wraps.
+    if((int8_t)(frameCount - p_task->wake) < 0) continue;
+
+    p_taskCurrent = p_task;
+
+    coSp = p_task->sp;
+
+    coSwap();
+
+    p_task->sp = coSp;
+
+    p_taskCurrent = 0;
+
+    if(p_task->state == TASK_DONE) taskList[index] = 0;
+  }
+}
+
+void yield(void)
+{
+  if(!p_taskCurrent) return;
+
+  coSwap();
+}
+
+void wait_frames(uint8_t frames)
+{
+  if(!p_taskCurrent) return;
+
+  p_taskCurrent->wake = frameCount + frames;
+
+  coSwap();
+}
@@ -32,39 +32,193 @@
 
 #include <stdint.h>
 
+/** DEFINES **/
+/**
+ * @def GI_SND_CLK
+ * sound chip clock in hertz, set per target in the arch defines.h.
+ */
+#ifndef GI_SND_CLK
+#define GI_SND_CLK 1789772
+#endif
+/**
+ * @def GI_NOTES
+ * notes in the pitch table, 0 is C1, 95 is B8.
+ */
+#define GI_NOTES 96
+/**
+ * @def GI_FINE_STEPS
+ * fine tune steps per semitone, low 4 bits of a pitch.
+ */
+#define GI_FINE_STEPS 16
+/**
+ * @def GI_MAX_DIV
+ * largest tone divider, 12 bit.
+ */
+#define GI_MAX_DIV 0x0FFF
+/**
+ * @def GI_IO_A_REG
+ * io port A register, joystick input on msx.
+ */
+#define GI_IO_A_REG 14
+/**
+ * @def GI_IO_B_REG
+ * io port B register, joystick select and pin outputs on msx.
+ */
+#define GI_IO_B_REG 15
+/**
+ * @def GI_MIXER_IO
+ * mixer register io port bits, kept by every mixer write. MSX needs port A
+ * in and port B out for the joystick select.
+ */
+#ifdef _MSX
+#define GI_MIXER_IO 0x80
+#else
+#define GI_MIXER_IO 0x00
+#endif
+/**
+ * @def GI_NOTE
+ * note from octave 1 to 8 and semitone 0 (C) to 11 (B).
+ */
+#define GI_NOTE(octave, semitone) ((uint8_t)(((octave) - 1) * 12 + (semitone)))
+/**
+ * @def GI_PITCH
+ * pitch from a note and a fine tune of 0 to GI_FINE_STEPS - 1, each step
+ * is 1/16 of a semitone up. Adding to a pitch is a linear musical slide.
+ */
+#define GI_PITCH(note, fine) ((uint16_t)(((uint16_t)(note) << 4) | ((fine) & 0x0F)))
+/**
+ * @def GI_FREQ_DIV
+ * tone divider from a clock and frequency in hertz, folds at compile time
+ * for constant arguments.
+ */
+#define GI_FREQ_DIV(refClk, channelFreq) ((uint16_t)(((uint32_t)(refClk) / ((uint32_t)(channelFreq) << 4)) & 0x0FFF))
+/**
+ * @def GI_ENV_FREQ_DIV
+ * envelope divider from a clock and frequency in hertz, folds at compile
+ * time for constant arguments.
+ */
+#define GI_ENV_FREQ_DIV(refClk, channelFreq) ((uint16_t)((uint32_t)(refClk) / ((uint32_t)(channelFreq) << 8)))
+
+/** DATA STRUCTURES **/
+/**
+ * @struct s_gisndslide
+ * @brief Struct for a pitch slide, stepped once a frame.
+ */
+struct s_gisndslide
+{
+  /**
+   * @var s_gisndslide::pitch
+   * current pitch.
+   */
+  uint16_t pitch;
+  /**
+   * @var s_gisndslide::target
+   * pitch the slide stops at.
+   */
+  uint16_t target;
+  /**
+   * @var s_gisndslide::rate
+   * pitch steps per tick, 0 once the target is reached.
+   */
+  uint8_t rate;
+};
+
 /***************************************************************************//**
  * @brief   Initialize gisnd and mute
  ******************************************************************************/
 void initGISND();
 
 /***************************************************************************//**
- * @brief   Calculate frequency from hertz to binary value.
+ * @brief   Hold setter writes in the register shadow until commitGISND, so
+ *          several changes go out together with one interrupt disable.
+ * 
+ * @param   defer 1 to hold writes, 0 to commit and write on every set again.
+ ******************************************************************************/
+void setGISNDdefer(uint8_t defer);
+
+/***************************************************************************//**
+ * @brief   Current defer state, so code run from the irq can hold writes and 
+ *          put the state back after.
+ * 
+ * @return  1 while writes are held, 0 otherwise.
+ ******************************************************************************/
+uint8_t getGISNDdefer();
+
+/***************************************************************************//**
+ * @brief   Write registers that differ from what the chip holds, the envelope
+ *          shape only when set since it restarts the envelope. Interrupts are 
+ *          disabled once for the whole commit.
+ ******************************************************************************/
+void commitGISND();
+
+/***************************************************************************//**
+ * @brief   Calculate frequency from hertz to binary value. Use GI_FREQ_DIV
+ *          for constants and getGISNDpitchDiv for notes.
  *
  * @param   refClk is the reference clock in hertz for the sound chip.
  * @param   channelFreq is the target frequency in hertz.
  *
- * @return  A unsigned 16 bit number that will result in the freqency wanted. (* 32)
+ * @return  A unsigned 16 bit number that will result in the freqency wanted. (* 16)
  ******************************************************************************/
 uint16_t getGISND_FreqDiv(uint32_t refClk, uint32_t channelFreq);
 
 /***************************************************************************//**
- * @brief   Calculate envelope frequency from hertz to binary value.
+ * @brief   Calculate envelope frequency from hertz to binary value. Use
+ *          GI_ENV_FREQ_DIV for constants.
  *
  * @param   refClk is the reference clock in hertz for the sound chip.
  * @param   channelFreq is the target frequency in hertz.
  *
- * @return  A unsigned 16 bit number that will result in the freqency wanted. (* 512)
+ * @return  A unsigned 16 bit number that will result in the freqency wanted. (* 256)
  *  ******************************************************************************/
 uint16_t getGISND_EnvFreqDiv(uint32_t refClk, uint32_t channelFreq);
 
+/***************************************************************************//**
+ * @brief   Tone divider for a pitch from the note table, no division. The table
+ *          is built by the compiler for GI_SND_CLK, fine tune interpolates
+ *          to the next semitone and octaves shift with rounding.
+ * 
+ * @param   pitch GI_PITCH of a note and fine tune, clamps at the top note.
+ * 
+ * @return  Tone divider, clamped to GI_MAX_DIV.
+ ******************************************************************************/
+uint16_t getGISNDpitchDiv(uint16_t pitch);
+
+/***************************************************************************//**
+ * @brief   Start a pitch slide.
+ * 
+ * @param   p_slide pointer to struct to contain slide data.
+ * @param   from pitch to start at.
+ * @param   to pitch to stop at.
+ * @param   rate pitch steps per tick, GI_FINE_STEPS is a semitone a frame.
+ ******************************************************************************/
+void setGISNDslide(struct s_gisndslide * const p_slide, uint16_t from, uint16_t to, uint8_t rate);
+
+/***************************************************************************//**
+ * @brief   Step a slide once, call once a frame.
+ * 
+ * @param   p_slide pointer to struct to contain slide data.
+ * 
+ * @return  Tone divider of the new pitch, 0 if p_slide is null.
+ ******************************************************************************/
+uint16_t tickGISNDslide(struct s_gisndslide * const p_slide);
+
 /***************************************************************************//**
  * @brief   Set gisnd channel frequency
  * 
  * @param   channel Select channel A, B, or C (character input, upper case).
- * @param   freqDiv is binary number to set the frequency (f = refClk/(32*freqDiv))
+ * @param   freqDiv is binary number to set the frequency (f = refClk/(16*freqDiv))
  ******************************************************************************/
 void setGISNDchannel_freq(char channel, uint16_t freqDiv);
 
+/***************************************************************************//**
+ * @brief   Set gisnd channel to a pitch from the note table
+ * 
+ * @param   channel Select channel A, B, or C (character input, upper case).
+ * @param   pitch GI_PITCH of a note and fine tune.
+ ******************************************************************************/
+void setGISNDchannel_pitch(char channel, uint16_t pitch);
+
 /***************************************************************************//**
  * @brief   Set gisnd channel attenuation
  * 
@@ -79,20 +233,22 @@ void setGISNDchannel_attn(char channel, uint8_t attenuate, uint8_t select);
  *
  * @param   noise 0 is enable, 1 is off. bit order C = 2, B = 1, A = 0.
  * @param   tone  0 is enable, 1 is off. bit order C = 2, B = 1, A = 0.
+ *
+ * The io port bits are always GI_MIXER_IO.
  ******************************************************************************/
 void setGISNDmixer(uint8_t noise, uint8_t tone);
 
 /***************************************************************************//**
  * @brief   Set gisnd noise frequency
  * 
- * @param   freqDiv is binary number to set the frequency (f = refClk/(32*freqDiv))
+ * @param   freqDiv is binary number to set the frequency (f = refClk/(16*freqDiv))
  ******************************************************************************/
 void setGISNDnoise_freq(uint8_t freqDiv);
 
 /***************************************************************************//**
  * @brief   Set gisnd envelope frequency
  * 
- * @param   freqDiv is binary number to set the frequency (f = refClk/(512*freqDiv))
+ * @param   freqDiv is binary number to set the frequency (f = refClk/(256*freqDiv))
  ******************************************************************************/
 void setGISNDenv_freq(uint16_t freqDiv);
 
@@ -103,4 +259,23 @@ void setGISNDenv_freq(uint16_t freqDiv);
  ******************************************************************************/
 void setGISNDenv_shape(uint8_t shape);
 
+/***************************************************************************//**
+ * @brief   Set any gisnd register. Sound registers go through the shadow, 
+ *          the io port registers are written at once.
+ *
+ * @param   addr register 0 to 15.
+ * @param   data value to write.
+ ******************************************************************************/
+void setGISNDreg(uint8_t addr, uint8_t data);
+
+/***************************************************************************//**
+ * @brief   Read a register back from the chip through GI_SND_RDATA_PORT, not
+ *          the shadow, so io port A returns its input pins.
+ *
+ * @param   addr register 0 to 15.
+ *
+ * @return  value the chip holds.
+ ******************************************************************************/
+uint8_t getGISNDreg(uint8_t addr);
+
 #endif
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * @file    gisndpcm.h
+ * @brief   Sample playback for the gisnd sound chip.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Plays 4 bit samples by writing a channel level at a fixed rate
+ *          with its tone and noise mixed off. The pcm.h loops in base.lib are
+ *          cycle counted assembly with a constant period per sample, the
+ *          delay for each rate is worked out from CPU_CLK at compile time.
+ *          Playback blocks with interrupts off and the vdp lock held, on
+ *          coleco the vdp irq is the NMI, a frame landing in playback runs
+ *          after it from vdp_unlock. Turn it off with setTMS99XXirq first or
+ *          the held nmi still adds jitter.
+ *
+ *          Every sample period can also write one byte to vram, the data 
+ *          goes to the vdp write address the caller set before playing. The
+ *          step costs the same with or without vram data, so the rate holds.
+ *          vdpAddr is moved past the bytes written.
+ *          The loops use the alternate registers and ix.
+ *
+ *          Sample format, shared with sn76489pcm, made by the sn76489 driver
+ *          py/wav2pcm.py with --chip gi:
+ *            - byte 0 format in the low nibble, start level in the high.
+ *            - byte 1 rate, GI_PCM_4KHZ or GI_PCM_8KHZ.
+ *            - byte 2 and 3 data bytes, little endian.
+ *            - packed data, two levels a byte, high nibble first.
+ *            - delta data, four 2 bit codes a byte, high bits first, each 
+ *              moves the level by -2, -1, +1, or +2 and clamps at 0 and 15.
+ *          Levels are chip values, volume for the gisnd, so a sample has to
+ *          be converted for the chip it plays on.
+ *
+ * @version 0.0.1
+ *
+ * @license mit
+ *
+ * Copyright 2026 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_GISND_PCM
+#define __LIB_GISND_PCM
+
+#include <stdint.h>
+#include <pcm.h>
+
+/** DEFINES **/
+/**
+ * @def GI_PCM_HEADER
+ * bytes before the sample data.
+ */
+#define GI_PCM_HEADER PCM_HEADER
+/**
+ * @def GI_PCM_PACKED
+ * format, two 4 bit levels a byte.
+ */
+#define GI_PCM_PACKED PCM_PACKED
+/**
+ * @def GI_PCM_DELTA
+ * format, four 2 bit level deltas a byte.
+ */
+#define GI_PCM_DELTA PCM_DELTA
+/**
+ * @def GI_PCM_4KHZ
+ * rate, about 4000 samples a second.
+ */
+#define GI_PCM_4KHZ PCM_4KHZ
+/**
+ * @def GI_PCM_8KHZ
+ * rate, about 8000 samples a second.
+ */
+#define GI_PCM_8KHZ PCM_8KHZ
+
+/** DELTA TABLE **/
+/**
+ * @def c_gisndpcmDelta
+ * next level for level * 4 + delta code, the shared c_pcmDelta.
+ */
+#define c_gisndpcmDelta c_pcmDelta
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Play a sample on a channel and return when it ends. The channel
+ *          is muted after and the mixer put back.
+ *
+ * @param   channel Select channel A, B, or C (character input, upper case).
+ * @param   p_sample sample with header, see file details.
+ * @param   p_vram bytes to write to vram during playback, one a sample, 0 
+ *          for none. Bytes past the last sample are not written.
+ * @param   vramSize number of bytes in p_vram.
+ ******************************************************************************/
+void setGISNDpcmPlay(char channel, uint8_t const * const p_sample, uint8_t const * const p_vram, uint16_t vramSize);
+
+#endif
@@ -0,0 +1,329 @@
+/*******************************************************************************
+ * @file    gisndplayer.h
+ * @brief   Tracker style music player for the gisnd (AY-3-8910) sound chip.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Plays songs made by py/ft2gi.py. Each of the three channels runs
+ *          its own pattern, notes start an instrument (volume, mixer, and 
+ *          envelope per frame) and its ornament (semitone offsets per frame).
+ *          tickGISNDplayer builds all 14 registers in a frame image and hands
+ *          them to the gisnd driver, one commit writes only what differs from
+ *          its shadow, the envelope shape only when a note restarts it.
+ *          Channels an effect has blocked are left to the effect manager.
+ *
+ *          Song layout, 16 bit offsets are little endian from the song start:
+ *            - 0 speed, frames per row.
+ *            - 1 number of orders.
+ *            - 2 order to loop to.
+ *            - 3 offset of the order table, 3 pattern numbers per order.
+ *            - 5 offset of the pattern offset table.
+ *            - 7 offset of the instrument offset table.
+ *            - 9 offset of the ornament offset table.
+ *
+ *          Pattern commands:
+ *            - 0x00 to 0x5F, note C1 up, ends the row.
+ *            - 0x60, note off, ends the row.
+ *            - 0x80 to 0x9F, instrument.
+ *            - 0xA0 to 0xAF, channel volume, 15 is full.
+ *            - 0xC0 to 0xCF, envelope shape.
+ *            - 0xD0 nn, speed. 0xD1 nn, noise period.
+ *            - 0xE0 to 0xFE, 1 to 31 empty rows, ends the row.
+ *            - 0xFF, end of pattern.
+ *
+ *          Instruments are length, loop (0xFF holds the last step), 
+ *          ornament (0xFF for none), then one byte per frame of volume in the 
+ *          low nibble and the GI_INST_* flags. Ornaments are length, loop, 
+ *          then signed semitone offsets.
+ *
+ *          py/ft2gi.py has no AY mixer macro to read, so it reuses the
+ *          FamiTracker duty macro as the flags. Duty values 0 to 7 shift up 4
+ *          bits: 1 turns the tone off, 2 turns noise on, 4 takes the volume
+ *          from the envelope, added together. Duty 0 is a plain tone, duty 3
+ *          is noise only. The duty macro does not change the AY pulse width,
+ *          the AY only makes square waves.
+ *
+ * @version 0.0.1
+ *
+ * @license mit
+ *
+ * Copyright 2026 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_GISND_PLAYER
+#define __LIB_GISND_PLAYER
+
+#include <stdint.h>
+#include <gisnd.h>
+
+/** DEFINES **/
+/**
+ * @def GI_PLAYER_CHANNELS
+ * tone channels on the chip.
+ */
+#define GI_PLAYER_CHANNELS 3
+/**
+ * @def GI_PLAYER_REGS
+ * sound registers in the frame image, 0 to 13.
+ */
+#define GI_PLAYER_REGS 14
+/**
+ * @def GI_PLAYER_NOISE_CHAN
+ * blocked bit for the shared noise period register.
+ */
+#define GI_PLAYER_NOISE_CHAN 3
+/**
+ * @def GI_PLAYER_MIXER_REG
+ * mixer register, shared by all channels.
+ */
+#define GI_PLAYER_MIXER_REG 7
+/**
+ * @def GI_PLAYER_ALL
+ * dirty bits for every register below the envelope shape.
+ */
+#define GI_PLAYER_ALL 0x1FFF
+/**
+ * @def GI_PLAYER_NOTES
+ * notes a pattern can play, C1 to B8, the gisnd pitch table.
+ */
+#define GI_PLAYER_NOTES 96
+/**
+ * @def GI_PLAYER_NOTE_OFF
+ * note off command.
+ */
+#define GI_PLAYER_NOTE_OFF 0x60
+/**
+ * @def GI_PLAYER_INST
+ * instrument command, low 5 bits are the instrument.
+ */
+#define GI_PLAYER_INST 0x80
+/**
+ * @def GI_PLAYER_VOLUME
+ * channel volume command, low 4 bits are the volume.
+ */
+#define GI_PLAYER_VOLUME 0xA0
+/**
+ * @def GI_PLAYER_ENV
+ * envelope shape command, low 4 bits are the shape.
+ */
+#define GI_PLAYER_ENV 0xC0
+/**
+ * @def GI_PLAYER_SPEED
+ * speed command, followed by frames per row.
+ */
+#define GI_PLAYER_SPEED 0xD0
+/**
+ * @def GI_PLAYER_NOISE
+ * noise period command, followed by the period.
+ */
+#define GI_PLAYER_NOISE 0xD1
+/**
+ * @def GI_PLAYER_SKIP
+ * one empty row, up to 0xFE for 31.
+ */
+#define GI_PLAYER_SKIP 0xE0
+/**
+ * @def GI_PLAYER_END
+ * end of pattern command.
+ */
+#define GI_PLAYER_END 0xFF
+/**
+ * @def GI_PLAYER_NONE
+ * no loop or no ornament.
+ */
+#define GI_PLAYER_NONE 0xFF
+/**
+ * @def GI_INST_TONE_OFF
+ * instrument step flag, tone disabled.
+ */
+#define GI_INST_TONE_OFF 0x10
+/**
+ * @def GI_INST_NOISE
+ * instrument step flag, noise enabled.
+ */
+#define GI_INST_NOISE 0x20
+/**
+ * @def GI_INST_ENV
+ * instrument step flag, volume from the envelope, period follows the tone.
+ */
+#define GI_INST_ENV 0x40
+/**
+ * @def GI_PLAYER_MIXER_IO
+ * mixer register io port bits, same as the driver GI_MIXER_IO.
+ */
+#define GI_PLAYER_MIXER_IO GI_MIXER_IO
+
+/** DATA STRUCTURES **/
+/**
+ * @struct s_gisndplayerChannel
+ * @brief Struct for containing one channel of player state.
+ */
+struct s_gisndplayerChannel
+{
+  /**
+   * @var s_gisndplayerChannel::p_pattern
+   * next pattern command.
+   */
+  uint8_t const *p_pattern;
+  /**
+   * @var s_gisndplayerChannel::p_inst
+   * current instrument, 0 for none.
+   */
+  uint8_t const *p_inst;
+  /**
+   * @var s_gisndplayerChannel::p_orn
+   * current ornament, 0 for none.
+   */
+  uint8_t const *p_orn;
+  /**
+   * @var s_gisndplayerChannel::instPos
+   * instrument step.
+   */
+  uint8_t instPos;
+  /**
+   * @var s_gisndplayerChannel::ornPos
+   * ornament step.
+   */
+  uint8_t ornPos;
+  /**
+   * @var s_gisndplayerChannel::skip
+   * rows left before the next command.
+   */
+  uint8_t skip;
+  /**
+   * @var s_gisndplayerChannel::note
+   * current note.
+   */
+  uint8_t note;
+  /**
+   * @var s_gisndplayerChannel::volume
+   * channel volume, subtracted from the instrument volume.
+   */
+  uint8_t volume;
+  /**
+   * @var s_gisndplayerChannel::active
+   * 1 while a note sounds.
+   */
+  uint8_t active;
+};
+
+/**
+ * @struct s_gisndplayer
+ * @brief Struct for containing player state and the register frame image.
+ */
+struct s_gisndplayer
+{
+  /**
+   * @var s_gisndplayer::p_song
+   * song data, 0 for none.
+   */
+  uint8_t const *p_song;
+  /**
+   * @var s_gisndplayer::channel
+   * channel state A, B, C.
+   */
+  struct s_gisndplayerChannel channel[GI_PLAYER_CHANNELS];
+  /**
+   * @var s_gisndplayer::regs
+   * register frame image built each tick.
+   */
+  uint8_t regs[GI_PLAYER_REGS];
+  /**
+   * @var s_gisndplayer::dirty
+   * register bits changed since they went to the driver.
+   */
+  uint16_t dirty;
+  /**
+   * @var s_gisndplayer::blocked
+   * channel bits A, B, C, and GI_PLAYER_NOISE_CHAN owned by effects. While
+   * any are set the effect manager writes the mixer.
+   */
+  uint8_t blocked;
+  /**
+   * @var s_gisndplayer::order
+   * current order.
+   */
+  uint8_t order;
+  /**
+   * @var s_gisndplayer::speed
+   * frames per row.
+   */
+  uint8_t speed;
+  /**
+   * @var s_gisndplayer::tick
+   * frames into the current row.
+   */
+  uint8_t tick;
+  /**
+   * @var s_gisndplayer::envTrigger
+   * 1 when the envelope shape must be written.
+   */
+  uint8_t envTrigger;
+  /**
+   * @var s_gisndplayer::playing
+   * 1 while the song is running.
+   */
+  uint8_t playing;
+};
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Initialize the player with a song, stopped. The player also holds
+ *          the music image the effect manager gives channels back to, pass 0
+ *          for no music.
+ *
+ * @param   p_player pointer to struct to contain player data.
+ * @param   p_song song made by py/ft2gi.py, or 0.
+ ******************************************************************************/
+void initGISNDplayer(struct s_gisndplayer * const p_player, uint8_t const * const p_song);
+
+/***************************************************************************//**
+ * @brief   Start the song from the first order.
+ *
+ * @param   p_player pointer to struct to contain player data.
+ ******************************************************************************/
+void setGISNDplayerPlay(struct s_gisndplayer * const p_player);
+
+/***************************************************************************//**
+ * @brief   Stop the song and mute all channels.
+ *
+ * @param   p_player pointer to struct to contain player data.
+ ******************************************************************************/
+void setGISNDplayerStop(struct s_gisndplayer * const p_player);
+
+/***************************************************************************//**
+ * @brief   Check if the song is playing.
+ *
+ * @param   p_player pointer to struct to contain player data.
+ * @return  0 when stopped, 1 when playing.
+ ******************************************************************************/
+uint8_t getGISNDplayerBusy(struct s_gisndplayer * const p_player);
+
+/***************************************************************************//**
+ * @brief   Run one frame of the song and write changed registers. Call once 
+ *          per frame from the vdp irq callback, also when stopped. Main code 
+ *          should leave the chip alone while playing.
+ *
+ * @param   p_player pointer to struct to contain player data.
+ ******************************************************************************/
+void tickGISNDplayer(struct s_gisndplayer * const p_player);
+
+#endif
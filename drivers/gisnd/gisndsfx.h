@@ -0,0 +1,181 @@
+/*******************************************************************************
+ * @file    gisndsfx.h
+ * @brief   Sound effect manager for the gisnd (AY-3-8910) sound chip.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Plays effects on top of a gisndplayer. Each effect picks a free
+ *          channel from its channel mask, taking it from the music if needed,
+ *          or steals one from an effect of the same or lower priority. An
+ *          effect with mask bit 3 also claims the shared noise period. The
+ *          music keeps running in its register image while blocked and is
+ *          written back when the effect ends. tickGISNDsfx is called once a
+ *          frame from the vdp irq callback, after tickGISNDplayer.
+ *
+ *          Effect format, shared with sn76489sfx:
+ *            - byte 0 frames, byte 1 priority (higher wins), byte 2 channel 
+ *              mask (bits 0 to 2 tone, bit 3 noise period).
+ *            - then per frame, level (0 to 15, 15 loudest) or'd with the
+ *              GI_SFX_* flags, divider low byte, divider high nibble with the
+ *              noise setting in the upper nibble (period n * 2 + 1).
+ *
+ * @version 0.0.1
+ *
+ * @license mit
+ *
+ * Copyright 2026 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_GISND_SFX
+#define __LIB_GISND_SFX
+
+#include <stdint.h>
+#include <gisndplayer.h>
+
+/** DEFINES **/
+/**
+ * @def GI_SFX_CHANNELS
+ * tone channels effects can use.
+ */
+#define GI_SFX_CHANNELS 3
+/**
+ * @def GI_SFX_NONE
+ * no channel.
+ */
+#define GI_SFX_NONE 0xFF
+/**
+ * @def GI_SFX_HEADER
+ * bytes before the first frame.
+ */
+#define GI_SFX_HEADER 3
+/**
+ * @def GI_SFX_STEP
+ * bytes per frame.
+ */
+#define GI_SFX_STEP 3
+/**
+ * @def GI_SFX_NOISE
+ * frame flag, noise mixed in, period set if this effect owns it.
+ */
+#define GI_SFX_NOISE 0x10
+/**
+ * @def GI_SFX_TONE_OFF
+ * frame flag, tone mixed out.
+ */
+#define GI_SFX_TONE_OFF 0x20
+
+/** DATA STRUCTURES **/
+/**
+ * @struct s_gisndsfxVoice
+ * @brief Struct for containing one effect channel.
+ */
+struct s_gisndsfxVoice
+{
+  /**
+   * @var s_gisndsfxVoice::p_pos
+   * next frame of the effect, 0 when idle.
+   */
+  uint8_t const *p_pos;
+  /**
+   * @var s_gisndsfxVoice::frames
+   * frames left.
+   */
+  uint8_t frames;
+  /**
+   * @var s_gisndsfxVoice::priority
+   * priority of the running effect.
+   */
+  uint8_t priority;
+  /**
+   * @var s_gisndsfxVoice::mixer
+   * mixer bits for this channel, shifted into place.
+   */
+  uint8_t mixer;
+};
+
+/**
+ * @struct s_gisndsfx
+ * @brief Struct for containing effect manager state.
+ */
+struct s_gisndsfx
+{
+  /**
+   * @var s_gisndsfx::p_music
+   * player holding the music image channels go back to.
+   */
+  struct s_gisndplayer *p_music;
+  /**
+   * @var s_gisndsfx::voice
+   * effect state per channel.
+   */
+  struct s_gisndsfxVoice voice[GI_SFX_CHANNELS];
+  /**
+   * @var s_gisndsfx::noiseOwner
+   * channel owning the noise period, GI_SFX_NONE for the music.
+   */
+  uint8_t noiseOwner;
+};
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Initialize the effect manager.
+ *
+ * @param   p_sfx pointer to struct to contain effect data.
+ * @param   p_music player to share the chip with, initialized even if no 
+ *          music plays. Must stay valid.
+ ******************************************************************************/
+void initGISNDsfx(struct s_gisndsfx * const p_sfx, struct s_gisndplayer * const p_music);
+
+/***************************************************************************//**
+ * @brief   Start an effect on a channel from its mask.
+ *
+ * @param   p_sfx pointer to struct to contain effect data.
+ * @param   p_effect effect data, see file details.
+ * @return  channel used, GI_SFX_NONE if every allowed channel has a higher 
+ *          priority effect.
+ ******************************************************************************/
+uint8_t setGISNDsfxPlay(struct s_gisndsfx * const p_sfx, uint8_t const * const p_effect);
+
+/***************************************************************************//**
+ * @brief   Stop the effect on a channel and give it back to the music.
+ *
+ * @param   p_sfx pointer to struct to contain effect data.
+ * @param   channel channel returned by setGISNDsfxPlay.
+ ******************************************************************************/
+void setGISNDsfxStop(struct s_gisndsfx * const p_sfx, uint8_t channel);
+
+/***************************************************************************//**
+ * @brief   Channels with effects running.
+ *
+ * @param   p_sfx pointer to struct to contain effect data.
+ * @return  channel bits, 0 when idle.
+ ******************************************************************************/
+uint8_t getGISNDsfxBusy(struct s_gisndsfx * const p_sfx);
+
+/***************************************************************************//**
+ * @brief   Step all effects one frame. Call once per frame from the vdp irq
+ *          callback after tickGISNDplayer.
+ *
+ * @param   p_sfx pointer to struct to contain effect data.
+ ******************************************************************************/
+void tickGISNDsfx(struct s_gisndsfx * const p_sfx);
+
+#endif
@@ -0,0 +1,327 @@
+#!/usr/bin/env python3
+################################################################################
+# @file   ft2gi.py
+# @author Jay Convertino(jayconvertino@outlook.com)
+# @date   2026.10.19
+# @brief  Convert a FamiTracker text export to a gisndplayer song in a C header.
+#
+# The first three channels (pulse 1, pulse 2, triangle) become AY channels A, B,
+# and C. Noise channel notes set the AY noise period. Instrument volume macros
+# are the step volume, duty macros are the step flags (bit 0 tone off, bit 1 
+# noise on, bit 2 hardware envelope, so duty 0 is a tone and 3 is noise only),
+# the AY has no pulse width so duty is free for this. Arpeggio macros become
+# ornaments. Effects
+# Fxx (speed), Bxx (loop order), and Vxx (envelope shape) are kept.
+#
+# @license MIT
+# Copyright 2026 Jay Convertino
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to
+# deal in the Software without restriction, including without limitation the
+# rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+# sell copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+################################################################################
+import argparse
+import sys
+import re
+
+#pattern commands, see gisndplayer.h
+CMD_NOTE_OFF = 0x60
+CMD_INST     = 0x80
+CMD_VOLUME   = 0xA0
+CMD_ENV      = 0xC0
+CMD_SPEED    = 0xD0
+CMD_NOISE    = 0xD1
+CMD_SKIP     = 0xE0
+CMD_END      = 0xFF
+NONE         = 0xFF
+
+#notes start at C1
+NOTE_NAMES = {'C-':0, 'C#':1, 'D-':2, 'D#':3, 'E-':4, 'F-':5, 'F#':6, 'G-':7, 'G#':8, 'A-':9, 'A#':10, 'B-':11}
+NOTE_FIRST = 12
+NOTE_LAST  = 95
+
+#instrument step flags
+FLAG_SHIFT = 4
+
+def main():
+  args = parse_args(sys.argv[1:])
+
+  try:
+    with open(args.text, 'r') as file:
+      lines = file.readlines()
+  except FileNotFoundError as e:
+    print(str(e))
+    exit(1)
+
+  song = parse_text(lines, args.track)
+
+  data = build_song(song)
+
+  write_header(args.header, args.name, data)
+
+  print(f"{len(song['orders'])} ORDERS, {len(data)} BYTES")
+
+  exit(0)
+
+# pull macros, instruments, and one track out of the text export.
+def parse_text(lines, track_num):
+  song = {'macros': {}, 'instruments': {}, 'speed': 6, 'rows': 64, 'orders': [], 'patterns': {}}
+
+  track = -1
+  pattern = None
+
+  for line in lines:
+    words = line.split()
+
+    if not words:
+      continue
+
+    if words[0] == 'MACRO':
+      head, values = line.split(':', 1)
+      head = head.split()
+      song['macros'][(int(head[1]), int(head[2]))] = {'loop': int(head[3]), 'values': [int(v) for v in values.split()]}
+    elif words[0] == 'INST2A03':
+      song['instruments'][int(words[1])] = {'vol': int(words[2]), 'arp': int(words[3]), 'duty': int(words[6])}
+    elif words[0] == 'TRACK':
+      track += 1
+      if track == track_num:
+        song['rows'] = int(words[1])
+        song['speed'] = int(words[2])
+    elif track != track_num:
+      continue
+    elif words[0] == 'ORDER':
+      song['orders'].append([int(v, 16) for v in line.split(':', 1)[1].split()])
+    elif words[0] == 'PATTERN':
+      pattern = int(words[1], 16)
+      song['patterns'][pattern] = []
+    elif words[0] == 'ROW' and pattern is not None:
+      song['patterns'][pattern].append([cell.split() for cell in line.split(':')[1:]])
+
+  return song
+
+# macro values played out for a number of steps, holding or looping like the tracker.
+def macro_steps(macro, count):
+  out = []
+
+  if not macro or not macro['values']:
+    return [None] * count
+
+  pos = 0
+
+  for _ in range(count):
+    out.append(macro['values'][pos])
+    pos += 1
+    if pos >= len(macro['values']):
+      pos = macro['loop'] if macro['loop'] >= 0 else len(macro['values']) - 1
+
+  return out
+
+# instruments as length, loop, ornament, steps. ornaments as length, loop, offsets.
+def build_instruments(song):
+  instruments = []
+  ornaments = []
+  orn_index = {}
+
+  for num in range(max(song['instruments'].keys(), default=-1) + 1):
+    inst = song['instruments'].get(num, {'vol': -1, 'arp': -1, 'duty': -1})
+
+    vol = song['macros'].get((0, inst['vol'])) if inst['vol'] >= 0 else None
+    arp = song['macros'].get((1, inst['arp'])) if inst['arp'] >= 0 else None
+    duty = song['macros'].get((4, inst['duty'])) if inst['duty'] >= 0 else None
+
+    length = max(len(vol['values']) if vol else 1, len(duty['values']) if duty else 1)
+    loop = vol['loop'] if vol and vol['loop'] >= 0 else NONE
+
+    steps = []
+
+    for v, d in zip(macro_steps(vol, length), macro_steps(duty, length)):
+      steps.append((15 if v is None else v & 0x0F) | (((d or 0) & 0x07) << FLAG_SHIFT))
+
+    orn = NONE
+
+    if arp and arp['values']:
+      key = (arp['loop'], tuple(arp['values']))
+      if key not in orn_index:
+        orn_index[key] = len(ornaments)
+        ornaments.append([len(arp['values']), arp['loop'] if arp['loop'] >= 0 else NONE] + [v & 0xFF for v in arp['values']])
+      orn = orn_index[key]
+
+    instruments.append([length, loop, orn] + steps)
+
+  if not instruments:
+    instruments.append([1, NONE, NONE, 15])
+
+  return instruments, ornaments
+
+# note text to player note, None for no note.
+def parse_note(text):
+  if text in ('---', '==='):
+    return CMD_NOTE_OFF
+
+  if text[:2] not in NOTE_NAMES:
+    return None
+
+  note = int(text[2]) * 12 + NOTE_NAMES[text[:2]] - NOTE_FIRST
+
+  return min(max(note, 0), NOTE_LAST)
+
+# one channel of one pattern as commands.
+def build_channel(song, rows, chan):
+  out = []
+  empty = 0
+  loop = None
+
+  for row in rows[:song['rows']]:
+    cmds = []
+    note = None
+    cell = row[chan] if chan < len(row) else ['...']
+
+    if len(cell) > 1 and cell[1] != '..':
+      cmds.append(CMD_INST | (int(cell[1], 16) & 0x1F))
+
+    if len(cell) > 2 and cell[2] != '.':
+      cmds.append(CMD_VOLUME | int(cell[2], 16))
+
+    for effect in cell[3:]:
+      if effect[0] == 'F' and int(effect[1:], 16) < 0x20:
+        cmds += [CMD_SPEED, int(effect[1:], 16)]
+      elif effect[0] == 'V':
+        cmds.append(CMD_ENV | (int(effect[1:], 16) & 0x0F))
+      elif effect[0] == 'B':
+        loop = int(effect[1:], 16)
+
+    #the noise channel carries the noise period on channel A
+    if chan == 0 and len(row) > 3 and row[3][0][1:] == '-#':
+      cmds += [CMD_NOISE, (15 - int(row[3][0][0], 16)) * 2 + 1]
+
+    note = parse_note(cell[0])
+
+    if not cmds and note is None:
+      empty += 1
+      continue
+
+    out += skip_cmds(empty)
+    empty = 0
+    out += cmds
+
+    if note is None:
+      empty = 1
+    else:
+      out.append(note)
+
+  out += skip_cmds(empty)
+  out.append(CMD_END)
+
+  return out, loop
+
+# empty row commands.
+def skip_cmds(rows):
+  out = []
+
+  while rows > 0:
+    count = min(rows, 31)
+    out.append(CMD_SKIP + count - 1)
+    rows -= count
+
+  return out
+
+# whole song as bytes.
+def build_song(song):
+  instruments, ornaments = build_instruments(song)
+
+  patterns = []
+  pattern_index = {}
+  orders = []
+  loop_order = 0
+
+  for order in song['orders']:
+    entry = []
+
+    for chan in range(3):
+      data, loop = build_channel(song, song['patterns'].get(order[chan], []), chan)
+
+      if loop is not None:
+        loop_order = loop
+
+      key = tuple(data)
+
+      if key not in pattern_index:
+        pattern_index[key] = len(patterns)
+        patterns.append(data)
+
+      entry.append(pattern_index[key])
+
+    orders.append(entry)
+
+  header = 11
+  data = [song['speed'], len(orders), min(loop_order, len(orders) - 1)]
+  body = []
+
+  order_tab = header + len(body)
+  for entry in orders:
+    body += entry
+
+  tables = []
+  for blocks in (patterns, instruments, ornaments):
+    offsets = []
+    table_pos = header + len(body)
+    body += [0, 0] * len(blocks)
+    for index, block in enumerate(blocks):
+      offsets.append(header + len(body))
+      body += block
+    for index, offset in enumerate(offsets):
+      body[table_pos - header + index * 2] = offset & 0xFF
+      body[table_pos - header + index * 2 + 1] = offset >> 8
+    tables.append(table_pos)
+
+  for offset in [order_tab] + tables:
+    data += [offset & 0xFF, offset >> 8]
+
+  return data + body
+
+# write the song as a C header.
+def write_header(path, name, data):
+  lines = []
+
+  for index in range(0, len(data), 16):
+    lines.append("  " + ", ".join(f"0x{byte:02X}" for byte in data[index:index+16]))
+
+  try:
+    with open(path, 'w') as file:
+      file.write(f"/* generated by ft2gi.py, {len(data)} bytes */\n")
+      file.write(f"const uint8_t {name}[] =\n{{\n")
+      file.write(",\n".join(lines))
+      file.write("\n};\n")
+  except FileNotFoundError as e:
+    print(str(e))
+    exit(1)
+
+# parse args for tuning build
+def parse_args(argv):
+  parser = argparse.ArgumentParser(description='Convert a FamiTracker text export (File, Export text) to a compact song for the gisndplayer.',
+                                   epilog='Duty macros are not pulse widths on the AY, each value is the GI_INST flags of the step. 0 tone, 1 silent (tone off), 2 tone and noise, 3 noise only, add 4 to take the volume from the hardware envelope.')
+
+  parser.add_argument('--text',   action='store', default="music.txt", dest='text',   required=False, help='FamiTracker text export to convert.')
+  parser.add_argument('--header', action='store', default="music.h",   dest='header', required=False, help='Location and name of header file to write.')
+  parser.add_argument('--name',   action='store', default="c_music",   dest='name',   required=False, help='Name of the C array.')
+  parser.add_argument('--track',  action='store', default=0,           dest='track',  required=False, type=int, help='Track number in the module, first is 0.')
+
+  return parser.parse_args()
+
+# name is main is main
+if __name__=="__main__":
+  main()
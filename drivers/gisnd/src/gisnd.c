@@ -49,18 +49,36 @@
 #define ENVELOPE_SHAPE  13
 #define NON_VALID_ADDR  14
 #define CONTROL_POWER   15
+#define NUM_REGS        14
+#define UNKNOWN         0xFF
+
+/** REGISTER SHADOW **/
+/*** registers as set, mixer starts with noise off and the target io bits ***/
+static uint8_t regImage[NUM_REGS] = {0, 0, 0, 0, 0, 0, 0, GI_MIXER_IO | 0x38};
+/*** registers as the chip holds them, unknown until first written ***/
+static uint8_t regShadow[NUM_REGS] = {UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN};
+/*** shape writes restart the envelope, write even if unchanged ***/
+static uint8_t envTrigger = 0;
+/*** hold writes until commit ***/
+static uint8_t deferWrite = 0;
 
 /** SEE MY PRIVATES **/
 /*** send address to port and control chip ***/
 inline void sendAddr(uint8_t addr);
 /*** send data to port and control chip ***/
 inline void sendData(uint8_t data);
+/*** store a register in the image, write it unless deferred ***/
+static void setImage(uint8_t addr, uint8_t data);
 
 /** INITIALIZE AND FREE MY STRUCTS **/
 
 /*** Initialize gisnd struct ports ***/
 void initGISND()
 {
+  uint8_t defer = deferWrite;
+
+  deferWrite = 1;
+
   /**** mute all ****/
   
   setGISNDchannel_attn('A', 0, 0);
@@ -68,18 +86,161 @@ void initGISND()
   setGISNDchannel_attn('B', 0, 0);
   
   setGISNDchannel_attn('C', 0, 0);
+
+  deferWrite = defer;
+
+  if(!deferWrite) commitGISND();
+}
+
+/*** hold writes ***/
+void setGISNDdefer(uint8_t defer)
+{
+  deferWrite = defer;
+
+  if(!deferWrite) commitGISND();
+}
+
+/*** defer state ***/
+uint8_t getGISNDdefer()
+{
+  return deferWrite;
+}
+
+/*** write changed registers ***/
+void commitGISND()
+{
+  uint8_t addr = 0;
+
+  vdp_lock();
+
+  for(addr = 0; addr < ENVELOPE_SHAPE; addr++)
+  {
+    if(regImage[addr] == regShadow[addr]) continue;
+
+    regShadow[addr] = regImage[addr];
+
+    sendAddr(addr);
+    sendData(regImage[addr]);
+  }
+
+  if(envTrigger)
+  {
+    envTrigger = 0;
+
+    regShadow[ENVELOPE_SHAPE] = regImage[ENVELOPE_SHAPE];
+
+    sendAddr(ENVELOPE_SHAPE);
+    sendData(regImage[ENVELOPE_SHAPE]);
+  }
+
+  vdp_unlock();
 }
 
 /*** calculate freqDiv ***/
 uint16_t getGISND_FreqDiv(uint32_t refClk, uint32_t channelFreq)
 {
-  return (refClk/(channelFreq << 5)) & 0x0FFF;
+  return GI_FREQ_DIV(refClk, channelFreq);
 }
 
 /*** calculate envelope freqDiv ***/
 uint16_t getGISND_EnvFreqDiv(uint32_t refClk, uint32_t channelFreq)
 {
-  return (refClk/(channelFreq << 9));
+  return GI_ENV_FREQ_DIV(refClk, channelFreq);
+}
+
+/** PITCH TABLE **/
+/*** clock scaled for dividers from millihertz, clk * 1000 / 16 ***/
+#define NOTE_CLK ((uint32_t)GI_SND_CLK * 125 / 2)
+/*** divider for a note in millihertz, folded by the compiler ***/
+#define NOTE_DIV(milliHz) (uint16_t)((NOTE_CLK + ((milliHz) >> 1)) / (milliHz))
+
+/*** C0 to C1, octave 0 keeps an extra bit for the rounding shift ***/
+static const uint16_t c_noteDiv[13] =
+{
+  NOTE_DIV(16352), NOTE_DIV(17324), NOTE_DIV(18354), NOTE_DIV(19445),
+  NOTE_DIV(20602), NOTE_DIV(21827), NOTE_DIV(23125), NOTE_DIV(24500),
+  NOTE_DIV(25957), NOTE_DIV(27500), NOTE_DIV(29135), NOTE_DIV(30868),
+  NOTE_DIV(32703)
+};
+
+/*** pitch to divider ***/
+uint16_t getGISNDpitchDiv(uint16_t pitch)
+{
+  uint8_t note = 0;
+  uint8_t fine = 0;
+  uint8_t shift = 1;
+  uint16_t step = 0;
+  uint16_t sum = 0;
+  uint16_t div = 0;
+
+  if(pitch > GI_PITCH(GI_NOTES - 1, 0)) pitch = GI_PITCH(GI_NOTES - 1, 0);
+
+  note = (uint8_t)(pitch >> 4);
+
+  fine = (uint8_t)pitch & 0x0F;
+
+  for(; note >= 12; note -= 12) shift++;
+
+  div = c_noteDiv[note];
+
+  /**** fine tune moves toward the next semitone, shift and add multiply ****/
+  step = div - c_noteDiv[note + 1];
+
+  if(fine & 0x01) sum += step;
+  if(fine & 0x02) sum += step << 1;
+  if(fine & 0x04) sum += step << 2;
+  if(fine & 0x08) sum += step << 3;
+
+  div -= sum >> 4;
+
+  /**** round the shifted bits ****/
+  div = (div + (1 << (shift - 1))) >> shift;
+
+  return (div > GI_MAX_DIV ? GI_MAX_DIV : div);
+}
+
+/*** start a slide ***/
+void setGISNDslide(struct s_gisndslide * const p_slide, uint16_t from, uint16_t to, uint8_t rate)
+{
+  /**** NULL Check ****/
+  if(!p_slide) return;
+
+  p_slide->pitch = from;
+
+  p_slide->target = to;
+
+  p_slide->rate = (from == to ? 0 : rate);
+}
+
+/*** step a slide ***/
+uint16_t tickGISNDslide(struct s_gisndslide * const p_slide)
+{
+  uint16_t left = 0;
+
+  /**** NULL Check ****/
+  if(!p_slide) return 0;
+
+  if(p_slide->rate)
+  {
+    left = (p_slide->pitch < p_slide->target ? p_slide->target - p_slide->pitch : p_slide->pitch - p_slide->target);
+
+    if(left <= p_slide->rate)
+    {
+      p_slide->pitch = p_slide->target;
+
+      p_slide->rate = 0;
+    }
+    else if(p_slide->pitch < p_slide->target)
+    {
+      p_slide->pitch += p_slide->rate;
+    }
+    else
+    {
+      p_slide->pitch -= p_slide->rate;
+    }
+  }
+
+  return getGISNDpitchDiv(p_slide->pitch);
 }
 
 /** SET YOUR DATA **/
@@ -87,6 +248,7 @@ uint16_t getGISND_EnvFreqDiv(uint32_t refClk, uint32_t channelFreq)
 /*** set gisnd channel frequency ***/
 void setGISNDchannel_freq(char channel, uint16_t freqDiv)
 {
+  uint8_t defer = deferWrite;
   uint8_t addr_l;
   uint8_t addr_h;
   
@@ -109,11 +271,20 @@ void setGISNDchannel_freq(char channel, uint16_t freqDiv)
       return;
   }
   
-  sendAddr(addr_l);
-  sendData(freqDiv & 0x00FF);
+  /**** both halves in one commit, each only if it changed ****/
+  deferWrite = 1;
 
-  sendAddr(addr_h);
-  sendData((freqDiv >> 8) & 0x000F);
+  setImage(addr_l, freqDiv & 0x00FF);
+
+  deferWrite = defer;
+
+  setImage(addr_h, (freqDiv >> 8) & 0x000F);
+}
+
+/*** set gisnd channel pitch ***/
+void setGISNDchannel_pitch(char channel, uint16_t pitch)
+{
+  setGISNDchannel_freq(channel, getGISNDpitchDiv(pitch));
 }
 
 /*** set gisnd channel attenuation ***/
@@ -137,55 +308,97 @@ void setGISNDchannel_attn(char channel, uint8_t attenuate, uint8_t select)
       return;
   }
   
-  sendAddr(addr);
-  sendData((attenuate & (unsigned)0x0F) | (unsigned)(select << 4));
+  setImage(addr, (attenuate & (unsigned)0x0F) | (unsigned)(select << 4));
 }
 
 void setGISNDmixer(uint8_t noise, uint8_t tone)
 {
-  sendAddr(MIXER_SETTING);
-  sendData((unsigned)(noise << 3) | tone);
+  setImage(MIXER_SETTING, GI_MIXER_IO | (((unsigned)(noise << 3) | tone) & (unsigned)0x3F));
 }
 
 /*** set gisnd noise frequency ***/
 void setGISNDnoise_freq(uint8_t freqDiv)
 {
-  sendAddr(NOISE_FREQ);
-  sendData(freqDiv & (unsigned)0x1F);
+  setImage(NOISE_FREQ, freqDiv & (unsigned)0x1F);
 }
 
 /*** set gisnd envelope frequency***/
 void setGISNDenv_freq(uint16_t freqDiv)
 {
-  sendAddr(ENVELOPE_FREQ_L);
-  sendData(freqDiv & 0x00FF);
+  uint8_t defer = deferWrite;
+
+  deferWrite = 1;
+
+  setImage(ENVELOPE_FREQ_L, freqDiv & 0x00FF);
+
+  deferWrite = defer;
 
-  sendAddr(ENVELOPE_FREQ_H);
-  sendData((freqDiv >> 8) & 0x00FF);
+  setImage(ENVELOPE_FREQ_H, (freqDiv >> 8) & 0x00FF);
 }
 
 void setGISNDenv_shape(uint8_t shape)
 {
-  sendAddr(ENVELOPE_SHAPE);
-  sendData(shape & (unsigned)0x0F);
+  envTrigger = 1;
+
+  setImage(ENVELOPE_SHAPE, shape & (unsigned)0x0F);
 }
 
-/*** send address to chip ***/
-inline void sendAddr(uint8_t addr)
+/*** set any register ***/
+void setGISNDreg(uint8_t addr, uint8_t data)
 {
-  di();
+  addr &= (unsigned)0x0F;
 
-  GI_SND_CP_PORT = addr;
+  if(addr == ENVELOPE_SHAPE) envTrigger = 1;
 
-  ei();
+  if(addr < NUM_REGS)
+  {
+    setImage(addr, data);
+
+    return;
+  }
+
+  vdp_lock();
+
+  sendAddr(addr);
+  sendData(data);
+
+  vdp_unlock();
+}
+
+/** GET YOUR DATA **/
+
+/*** read a register from the chip ***/
+uint8_t getGISNDreg(uint8_t addr)
+{
+  uint8_t data = 0;
+
+  vdp_lock();
+
+  sendAddr(addr & (unsigned)0x0F);
+
+  data = GI_SND_RDATA_PORT;
+
+  vdp_unlock();
+
+  return data;
+}
+
+/*** store a register in the image, write it unless deferred ***/
+static void setImage(uint8_t addr, uint8_t data)
+{
+  regImage[addr] = data;
+
+  if(!deferWrite) commitGISND();
+}
+
+/*** send address to chip, caller holds interrupts off ***/
+inline void sendAddr(uint8_t addr)
+{
+  GI_SND_CP_PORT = addr;
 }
 
-/*** send data to chip ***/
+/*** send data to chip, caller holds interrupts off ***/
 inline void sendData(uint8_t data)
 {
-  di();
-  
   GI_SND_WDATA_PORT = data;
-  
-  ei();
 }
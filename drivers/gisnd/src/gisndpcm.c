@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * @file    gisndpcm.c
+ * @brief   Sample playback for the gisnd sound chip.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Channel setup around the shared pcm.h loops, levels go out raw.
+ *
+ * @license mit
+ *
+ * Copyright 2026 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <base.h>
+#include <stdint.h>
+
+#include <gisnd.h>
+#include <gisndpcm.h>
+
+/** DEFINES **/
+#define MIXER_REG     7
+#define LEVEL_REG     8
+#define MIXER_OFF     0x09
+#define LEVEL_MUTE    0
+
+/** SET YOUR DATA **/
+
+/*** play a sample ***/
+void setGISNDpcmPlay(char channel, uint8_t const * const p_sample, uint8_t const * const p_vram, uint16_t vramSize)
+{
+  uint8_t index = 0;
+  uint8_t level = 0;
+  uint8_t mixer = 0;
+
+  /**** NULL Check ****/
+  if(!p_sample) return;
+
+  if((channel < 'A') || (channel > 'C')) return;
+
+  index = (uint8_t)(channel - 'A');
+
+  level = setPCMsample(p_sample, p_vram, vramSize);
+
+  if(level == PCM_INVALID) return;
+
+  setGISNDchannel_attn(channel, level, 0);
+
+  commitGISND();
+
+  /**** the lock holds the vdp nmi, di holds the spinner irq ****/
+  vdp_lock();
+
+  di();
+
+  /**** tone and noise off leave a flat level, the level register is the sample ****/
+  GI_SND_CP_PORT = MIXER_REG;
+
+  mixer = GI_SND_RDATA_PORT;
+
+  GI_SND_WDATA_PORT = mixer | (MIXER_OFF << index);
+
+  GI_SND_CP_PORT = LEVEL_REG + index;
+
+  /**** levels go out raw, no latch ****/
+  playPCM(GI_SND_WDATA_ADDR, 0);
+
+  /**** the shadow missed the loop writes, mute on the chip then in the image ****/
+  GI_SND_WDATA_PORT = LEVEL_MUTE;
+
+  GI_SND_CP_PORT = MIXER_REG;
+
+  GI_SND_WDATA_PORT = mixer;
+
+  ei();
+
+  vdp_unlock();
+
+  setGISNDchannel_attn(channel, LEVEL_MUTE, 0);
+}
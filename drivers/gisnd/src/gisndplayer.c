@@ -0,0 +1,437 @@
+/*******************************************************************************
+ * @file    gisndplayer.c
+ * @brief   Tracker style music player for the gisnd (AY-3-8910) sound chip.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Pattern, instrument, and ornament sequencer with a register frame 
+ *          image and changed register writes.
+ *
+ * @license mit
+ *
+ * Copyright 2026 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <base.h>
+#include <stdint.h>
+
+#include <gisnd.h>
+#include <gisndplayer.h>
+
+/** DEFINES **/
+#define SONG_SPEED      0
+#define SONG_ORDERS     1
+#define SONG_LOOP       2
+#define SONG_ORDER_TAB  3
+#define SONG_PATT_TAB   5
+#define SONG_INST_TAB   7
+#define SONG_ORN_TAB    9
+#define REC_LEN         0
+#define REC_LOOP        1
+#define INST_ORN        2
+#define INST_STEPS      3
+#define ORN_STEPS       2
+#define MIXER_REG       GI_PLAYER_MIXER_REG
+#define NOISE_REG       6
+#define LEVEL_REG       8
+#define ENV_FREQ_L_REG  11
+#define ENV_FREQ_H_REG  12
+#define ENV_SHAPE_REG   13
+#define DEFAULT_SHAPE   0x0C
+
+/*** blocked bits that stop the player writing each register, mixer is shared ***/
+static const uint8_t c_regBlock[ENV_SHAPE_REG] =
+{
+  0x01, 0x01, 0x02, 0x02, 0x04, 0x04, 0x08, 0x0F, 0x01, 0x02, 0x04, 0x00, 0x00
+};
+
+/** SEE MY PRIVATES **/
+/*** pointer from a 16 bit offset in the song ***/
+static uint8_t const *getPlayerPtr(uint8_t const *p_song, uint8_t const *p_offset);
+/*** pointer to entry index of an offset table ***/
+static uint8_t const *getPlayerEntry(uint8_t const *p_song, uint8_t table, uint8_t index);
+/*** load the patterns for an order ***/
+static void setPlayerOrder(struct s_gisndplayer * const p_player, uint8_t order);
+/*** run pattern commands for one row ***/
+static void stepPlayerRow(struct s_gisndplayer * const p_player);
+/*** build the frame image for a channel ***/
+static void buildPlayerChannel(struct s_gisndplayer * const p_player, uint8_t index);
+/*** hand dirty image registers to the driver ***/
+static void commitPlayerRegs(struct s_gisndplayer * const p_player);
+
+/** INITIALIZE AND FREE MY STRUCTS **/
+
+/*** Initialize the player ***/
+void initGISNDplayer(struct s_gisndplayer * const p_player, uint8_t const * const p_song)
+{
+  uint8_t index = 0;
+
+  /**** NULL Check ****/
+  if(!p_player) return;
+
+  p_player->playing = 0;
+
+  p_player->blocked = 0;
+
+  p_player->envTrigger = 0;
+
+  p_player->p_song = p_song;
+
+  for(index = 0; index < GI_PLAYER_REGS; index++)
+  {
+    p_player->regs[index] = 0;
+  }
+
+  /**** all dirty, first commit hands everything over ****/
+  p_player->dirty = GI_PLAYER_ALL;
+
+  /**** tone and noise off ****/
+  p_player->regs[MIXER_REG] = GI_PLAYER_MIXER_IO | 0x3F;
+}
+
+/** SET YOUR DATA **/
+
+/*** start the song ***/
+void setGISNDplayerPlay(struct s_gisndplayer * const p_player)
+{
+  uint8_t index = 0;
+
+  /**** NULL Check ****/
+  if(!p_player) return;
+
+  if(!p_player->p_song) return;
+
+  vdp_lock();
+
+  for(index = 0; index < GI_PLAYER_CHANNELS; index++)
+  {
+    p_player->channel[index].p_inst = 0;
+    p_player->channel[index].p_orn = 0;
+    p_player->channel[index].volume = 15;
+    p_player->channel[index].active = 0;
+  }
+
+  p_player->regs[ENV_SHAPE_REG] = DEFAULT_SHAPE;
+
+  p_player->envTrigger = 0;
+
+  p_player->speed = p_player->p_song[SONG_SPEED];
+
+  /**** first tick runs row 0 ****/
+  p_player->tick = p_player->speed - 1;
+
+  setPlayerOrder(p_player, 0);
+
+  p_player->playing = 1;
+
+  vdp_unlock();
+}
+
+/*** stop the song ***/
+void setGISNDplayerStop(struct s_gisndplayer * const p_player)
+{
+  uint8_t index = 0;
+
+  /**** NULL Check ****/
+  if(!p_player) return;
+
+  vdp_lock();
+
+  p_player->playing = 0;
+
+  /**** next commit silences the image ****/
+  for(index = 0; index < GI_PLAYER_CHANNELS; index++)
+  {
+    p_player->regs[LEVEL_REG + index] = 0;
+
+    p_player->dirty |= (1 << (LEVEL_REG + index));
+  }
+
+  vdp_unlock();
+}
+
+/** GET YOUR DATA **/
+
+/*** check if playing ***/
+uint8_t getGISNDplayerBusy(struct s_gisndplayer * const p_player)
+{
+  /**** NULL Check ****/
+  if(!p_player) return 0;
+
+  return p_player->playing;
+}
+
+/** TICK **/
+
+/*** run one frame ***/
+void tickGISNDplayer(struct s_gisndplayer * const p_player)
+{
+  uint8_t index = 0;
+
+  /**** NULL Check ****/
+  if(!p_player) return;
+
+  /**** stopped, still restore channels effects give back ****/
+  if(p_player->playing)
+  {
+    if(++p_player->tick >= p_player->speed)
+    {
+      p_player->tick = 0;
+
+      stepPlayerRow(p_player);
+    }
+
+    p_player->regs[MIXER_REG] = GI_PLAYER_MIXER_IO;
+
+    for(index = 0; index < GI_PLAYER_CHANNELS; index++)
+    {
+      buildPlayerChannel(p_player, index);
+    }
+
+    /**** whole image rebuilt, the driver drops what did not change ****/
+    p_player->dirty = GI_PLAYER_ALL;
+  }
+
+  commitPlayerRegs(p_player);
+}
+
+/*** pointer from a 16 bit offset in the song ***/
+static uint8_t const *getPlayerPtr(uint8_t const *p_song, uint8_t const *p_offset)
+{
+  return p_song + ((uint16_t)p_offset[0] | ((uint16_t)p_offset[1] << 8));
+}
+
+/*** pointer to entry index of an offset table ***/
+static uint8_t const *getPlayerEntry(uint8_t const *p_song, uint8_t table, uint8_t index)
+{
+  return getPlayerPtr(p_song, getPlayerPtr(p_song, &p_song[table]) + ((uint16_t)index << 1));
+}
+
+/*** load the patterns for an order ***/
+static void setPlayerOrder(struct s_gisndplayer * const p_player, uint8_t order)
+{
+  uint8_t index = 0;
+  uint8_t const *p_order = 0;
+
+  if(order >= p_player->p_song[SONG_ORDERS]) order = p_player->p_song[SONG_LOOP];
+
+  p_player->order = order;
+
+  p_order = getPlayerPtr(p_player->p_song, &p_player->p_song[SONG_ORDER_TAB]) + (uint16_t)order * GI_PLAYER_CHANNELS;
+
+  for(index = 0; index < GI_PLAYER_CHANNELS; index++)
+  {
+    p_player->channel[index].p_pattern = getPlayerEntry(p_player->p_song, SONG_PATT_TAB, p_order[index]);
+
+    p_player->channel[index].skip = 1;
+  }
+}
+
+/*** run pattern commands for one row ***/
+static void stepPlayerRow(struct s_gisndplayer * const p_player)
+{
+  uint8_t index = 0;
+  uint8_t command = 0;
+  struct s_gisndplayerChannel *p_chan = 0;
+
+  /**** patterns are the same length, channel A ends the order ****/
+  if((p_player->channel[0].skip == 1) && (*p_player->channel[0].p_pattern == GI_PLAYER_END))
+  {
+    setPlayerOrder(p_player, p_player->order + 1);
+  }
+
+  for(index = 0; index < GI_PLAYER_CHANNELS; index++)
+  {
+    p_chan = &p_player->channel[index];
+
+    if(--p_chan->skip) continue;
+
+    for(;;)
+    {
+      command = *p_chan->p_pattern++;
+
+      if(command < GI_PLAYER_NOTE_OFF)
+      {
+        p_chan->note = command;
+        p_chan->instPos = 0;
+        p_chan->ornPos = 0;
+        p_chan->active = 1;
+        p_chan->skip = 1;
+
+        /**** a new note restarts the envelope ****/
+        if(p_chan->p_inst && (p_chan->p_inst[INST_STEPS] & GI_INST_ENV)) p_player->envTrigger = 1;
+
+        break;
+      }
+
+      if(command == GI_PLAYER_NOTE_OFF)
+      {
+        p_chan->active = 0;
+        p_chan->skip = 1;
+        break;
+      }
+
+      if(command == GI_PLAYER_END)
+      {
+        /**** hold until channel A ends the order ****/
+        p_chan->p_pattern--;
+        p_chan->skip = 1;
+        break;
+      }
+
+      if(command >= GI_PLAYER_SKIP)
+      {
+        p_chan->skip = command - GI_PLAYER_SKIP + 1;
+        break;
+      }
+
+      switch(command & 0xE0)
+      {
+        case GI_PLAYER_INST:
+          p_chan->p_inst = getPlayerEntry(p_player->p_song, SONG_INST_TAB, command & 0x1F);
+
+          p_chan->p_orn = (p_chan->p_inst[INST_ORN] == GI_PLAYER_NONE ? 0 : getPlayerEntry(p_player->p_song, SONG_ORN_TAB, p_chan->p_inst[INST_ORN]));
+          break;
+        case GI_PLAYER_VOLUME:
+          p_chan->volume = command & 0x0F;
+          break;
+        default:
+          if((command & 0xF0) == GI_PLAYER_ENV)
+          {
+            p_player->regs[ENV_SHAPE_REG] = command & 0x0F;
+
+            p_player->envTrigger = 1;
+          }
+          else if(command == GI_PLAYER_SPEED)
+          {
+            p_player->speed = *p_chan->p_pattern++;
+          }
+          else if(command == GI_PLAYER_NOISE)
+          {
+            p_player->regs[6] = *p_chan->p_pattern++ & 0x1F;
+          }
+          break;
+      }
+    }
+  }
+}
+
+/*** build the frame image for a channel ***/
+static void buildPlayerChannel(struct s_gisndplayer * const p_player, uint8_t index)
+{
+  uint8_t  step = 0;
+  uint8_t  level = 0;
+  uint8_t  note = 0;
+  uint16_t divider = 0;
+  struct s_gisndplayerChannel *p_chan = &p_player->channel[index];
+
+  /**** silent channel, tone and noise off ****/
+  if(!p_chan->active || !p_chan->p_inst)
+  {
+    p_player->regs[LEVEL_REG + index] = 0;
+
+    p_player->regs[MIXER_REG] |= (0x09 << index);
+
+    return;
+  }
+
+  step = p_chan->p_inst[INST_STEPS + p_chan->instPos];
+
+  if(++p_chan->instPos >= p_chan->p_inst[REC_LEN])
+  {
+    p_chan->instPos = (p_chan->p_inst[REC_LOOP] == GI_PLAYER_NONE ? p_chan->p_inst[REC_LEN] - 1 : p_chan->p_inst[REC_LOOP]);
+  }
+
+  note = p_chan->note;
+
+  if(p_chan->p_orn)
+  {
+    note += (int8_t)p_chan->p_orn[ORN_STEPS + p_chan->ornPos];
+
+    if(++p_chan->ornPos >= p_chan->p_orn[REC_LEN])
+    {
+      p_chan->ornPos = (p_chan->p_orn[REC_LOOP] == GI_PLAYER_NONE ? p_chan->p_orn[REC_LEN] - 1 : p_chan->p_orn[REC_LOOP]);
+    }
+  }
+
+  /**** wrapped below C1 ****/
+  if(note >= 0x80) note = 0;
+
+  divider = getGISNDpitchDiv(GI_PITCH(note, 0));
+
+  p_player->regs[index << 1] = (uint8_t)divider;
+  p_player->regs[(index << 1) + 1] = (uint8_t)(divider >> 8) & 0x0F;
+
+  /**** levels are about 3dB a step, subtracting scales the volume ****/
+  level = step & 0x0F;
+
+  level = (level > 15 - p_chan->volume ? level - (15 - p_chan->volume) : 0);
+
+  if(step & GI_INST_ENV)
+  {
+    level = 0x10;
+
+    /**** buzzer, envelope period follows the tone ****/
+    p_player->regs[ENV_FREQ_L_REG] = (uint8_t)(divider >> 4);
+    p_player->regs[ENV_FREQ_H_REG] = 0;
+  }
+
+  p_player->regs[LEVEL_REG + index] = level;
+
+  if(step & GI_INST_TONE_OFF) p_player->regs[MIXER_REG] |= (0x01 << index);
+
+  if(!(step & GI_INST_NOISE)) p_player->regs[MIXER_REG] |= (0x08 << index);
+}
+
+/*** hand dirty image registers to the driver, one commit, already in the irq ***/
+static void commitPlayerRegs(struct s_gisndplayer * const p_player)
+{
+  uint8_t index = 0;
+  uint8_t defer = 0;
+
+  if(!p_player->dirty && !p_player->envTrigger) return;
+
+  /**** main code may be holding writes, leave them held for its commit ****/
+  defer = getGISNDdefer();
+
+  setGISNDdefer(1);
+
+  for(index = 0; index < ENV_SHAPE_REG; index++)
+  {
+    if(!(p_player->dirty & (1 << index))) continue;
+
+    /**** effect owns the register, stays dirty for when it gives it back ****/
+    if(p_player->blocked & c_regBlock[index]) continue;
+
+    p_player->dirty &= ~(1 << index);
+
+    setGISNDreg(index, p_player->regs[index]);
+  }
+
+  /**** writing the shape restarts the envelope, only when asked ****/
+  if(p_player->envTrigger)
+  {
+    p_player->envTrigger = 0;
+
+    setGISNDenv_shape(p_player->regs[ENV_SHAPE_REG]);
+  }
+
+  if(!defer) setGISNDdefer(0);
+}
@@ -0,0 +1,283 @@
+/*******************************************************************************
+ * @file    gisndsfx.c
+ * @brief   Sound effect manager for the gisnd (AY-3-8910) sound chip.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Priority channel allocation over the music player image.
+ *
+ * @license mit
+ *
+ * Copyright 2026 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <base.h>
+#include <stdint.h>
+
+#include <gisnd.h>
+#include <gisndsfx.h>
+
+/** DEFINES **/
+#define SFX_FRAMES    0
+#define SFX_PRIORITY  1
+#define SFX_MASK      2
+#define SFX_NOISE_BIT 0x08
+#define LEVEL_MASK    0x0F
+#define NOISE_REG     6
+#define LEVEL_REG     8
+
+/** SEE MY PRIVATES **/
+/*** end the effect on a channel, music takes it back on its next tick ***/
+static void setSFXrelease(struct s_gisndsfx * const p_sfx, uint8_t channel);
+
+/** INITIALIZE AND FREE MY STRUCTS **/
+
+/*** Initialize effect manager ***/
+void initGISNDsfx(struct s_gisndsfx * const p_sfx, struct s_gisndplayer * const p_music)
+{
+  uint8_t index = 0;
+
+  /**** NULL Check ****/
+  if(!p_sfx) return;
+
+  p_sfx->p_music = p_music;
+
+  p_sfx->noiseOwner = GI_SFX_NONE;
+
+  for(index = 0; index < GI_SFX_CHANNELS; index++)
+  {
+    p_sfx->voice[index].p_pos = 0;
+    p_sfx->voice[index].frames = 0;
+    p_sfx->voice[index].priority = 0;
+    p_sfx->voice[index].mixer = 0;
+  }
+}
+
+/** SET YOUR DATA **/
+
+/*** start an effect ***/
+uint8_t setGISNDsfxPlay(struct s_gisndsfx * const p_sfx, uint8_t const * const p_effect)
+{
+  uint8_t index = 0;
+  uint8_t channel = GI_SFX_NONE;
+  uint8_t priority = 0;
+  struct s_gisndsfxVoice *p_voice = 0;
+
+  /**** NULL Check ****/
+  if(!p_sfx) return GI_SFX_NONE;
+
+  if(!p_sfx->p_music) return GI_SFX_NONE;
+
+  if(!p_effect) return GI_SFX_NONE;
+
+  if(!p_effect[SFX_FRAMES]) return GI_SFX_NONE;
+
+  priority = p_effect[SFX_PRIORITY];
+
+  vdp_lock();
+
+  /**** free channel first, music always yields, else the lowest priority effect not above ours ****/
+  for(index = 0; index < GI_SFX_CHANNELS; index++)
+  {
+    if(!(p_effect[SFX_MASK] & (1 << index))) continue;
+
+    p_voice = &p_sfx->voice[index];
+
+    if(!p_voice->p_pos)
+    {
+      channel = index;
+
+      break;
+    }
+
+    if((p_voice->priority <= priority) && ((channel == GI_SFX_NONE) || (p_voice->priority < p_sfx->voice[channel].priority)))
+    {
+      channel = index;
+    }
+  }
+
+  if(channel != GI_SFX_NONE)
+  {
+    /**** stolen channel may own the noise, give it up first ****/
+    if(p_sfx->voice[channel].p_pos) setSFXrelease(p_sfx, channel);
+
+    p_voice = &p_sfx->voice[channel];
+
+    p_voice->frames = p_effect[SFX_FRAMES];
+
+    p_voice->priority = priority;
+
+    p_voice->mixer = (0x09 << channel);
+
+    p_voice->p_pos = p_effect + GI_SFX_HEADER;
+
+    p_sfx->p_music->blocked |= (1 << channel);
+
+    /**** shared noise period, music yields, effects by priority ****/
+    if(p_effect[SFX_MASK] & SFX_NOISE_BIT)
+    {
+      if((p_sfx->noiseOwner == GI_SFX_NONE) || (p_sfx->voice[p_sfx->noiseOwner].priority <= priority))
+      {
+        p_sfx->noiseOwner = channel;
+
+        p_sfx->p_music->blocked |= (1 << GI_PLAYER_NOISE_CHAN);
+      }
+    }
+  }
+
+  vdp_unlock();
+
+  return channel;
+}
+
+/*** stop an effect ***/
+void setGISNDsfxStop(struct s_gisndsfx * const p_sfx, uint8_t channel)
+{
+  /**** NULL Check ****/
+  if(!p_sfx) return;
+
+  if(channel >= GI_SFX_CHANNELS) return;
+
+  vdp_lock();
+
+  setSFXrelease(p_sfx, channel);
+
+  vdp_unlock();
+}
+
+/** GET YOUR DATA **/
+
+/*** channels with effects ***/
+uint8_t getGISNDsfxBusy(struct s_gisndsfx * const p_sfx)
+{
+  uint8_t index = 0;
+  uint8_t busy = 0;
+
+  /**** NULL Check ****/
+  if(!p_sfx) return 0;
+
+  for(index = 0; index < GI_SFX_CHANNELS; index++)
+  {
+    if(p_sfx->voice[index].p_pos) busy |= (1 << index);
+  }
+
+  return busy;
+}
+
+/** TICK **/
+
+/*** step effects through the driver image, one commit, already in the irq ***/
+void tickGISNDsfx(struct s_gisndsfx * const p_sfx)
+{
+  uint8_t  index = 0;
+  uint8_t  level = 0;
+  uint8_t  mixer = 0;
+  uint8_t  owned = 0;
+  uint8_t  defer = 0;
+  struct s_gisndsfxVoice *p_voice = 0;
+  struct s_gisndplayer *p_music = 0;
+
+  /**** NULL Check ****/
+  if(!p_sfx) return;
+
+  p_music = p_sfx->p_music;
+
+  if(!p_music) return;
+
+  /**** main code may be holding writes, leave them held for its commit ****/
+  defer = getGISNDdefer();
+
+  setGISNDdefer(1);
+
+  for(index = 0; index < GI_SFX_CHANNELS; index++)
+  {
+    p_voice = &p_sfx->voice[index];
+
+    if(!p_voice->p_pos) continue;
+
+    if(!p_voice->frames)
+    {
+      setSFXrelease(p_sfx, index);
+
+      continue;
+    }
+
+    p_voice->frames--;
+
+    level = p_voice->p_pos[0];
+
+    /**** the driver shadow tracks the chip, so only changes are written ****/
+    setGISNDreg(index << 1, p_voice->p_pos[1]);
+
+    setGISNDreg((index << 1) + 1, p_voice->p_pos[2] & 0x0F);
+
+    if((level & GI_SFX_NOISE) && (p_sfx->noiseOwner == index))
+    {
+      setGISNDreg(NOISE_REG, ((p_voice->p_pos[2] >> 3) & 0x1E) | 1);
+    }
+
+    setGISNDreg(LEVEL_REG + index, level & LEVEL_MASK);
+
+    /**** 0 enables, tone bit then noise bit 3 up ****/
+    p_voice->mixer = ((level & GI_SFX_TONE_OFF ? 0x01 : 0x00) | (level & GI_SFX_NOISE ? 0x00 : 0x08)) << index;
+
+    p_voice->p_pos += GI_SFX_STEP;
+  }
+
+  /**** mixer is shared, merge effect bits over the music image ****/
+  for(index = 0; index < GI_SFX_CHANNELS; index++)
+  {
+    if(!p_sfx->voice[index].p_pos) continue;
+
+    owned |= (0x09 << index);
+
+    mixer |= p_sfx->voice[index].mixer;
+  }
+
+  if(owned) setGISNDreg(GI_PLAYER_MIXER_REG, (p_music->regs[GI_PLAYER_MIXER_REG] & ~owned) | mixer);
+
+  if(!defer) setGISNDdefer(0);
+}
+
+/*** end the effect on a channel, music takes it back on its next tick ***/
+static void setSFXrelease(struct s_gisndsfx * const p_sfx, uint8_t channel)
+{
+  struct s_gisndplayer *p_music = p_sfx->p_music;
+
+  p_sfx->voice[channel].p_pos = 0;
+
+  p_sfx->voice[channel].frames = 0;
+
+  p_sfx->voice[channel].priority = 0;
+
+  p_music->blocked &= ~(1 << channel);
+
+  /**** effect left its own values in the driver, hand the music ones back ****/
+  p_music->dirty |= (0x03 << (channel << 1)) | (1 << (LEVEL_REG + channel)) | (1 << GI_PLAYER_MIXER_REG);
+
+  if(p_sfx->noiseOwner == channel)
+  {
+    p_sfx->noiseOwner = GI_SFX_NONE;
+
+    p_music->blocked &= ~(1 << GI_PLAYER_NOISE_CHAN);
+
+    p_music->dirty |= (1 << NOISE_REG);
+  }
+}
@@ -0,0 +1,285 @@
+#!/usr/bin/env python3
+################################################################################
+# @file   vgm2sn.py
+# @author Jay Convertino(jayconvertino@outlook.com)
+# @date   2026.10.19
+# @brief  Convert a SN76489 VGM file to a sn76489player stream in a C header.
+#
+# @license MIT
+# Copyright 2026 Jay Convertino
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to
+# deal in the Software without restriction, including without limitation the
+# rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+# sell copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+################################################################################
+import argparse
+import sys
+import gzip
+
+#vgm samples per second
+VGM_RATE = 44100
+
+#stream commands, see sn76489player.h
+CMD_END      = 0x00
+CMD_WAIT_MAX = 0x3F
+NO_LOOP      = 0xFFFF
+
+#vgm command bytes with operands that are skipped, 0x67 data blocks add their size
+CMD_SIZES = {0x4F: 2, 0x67: 7, 0x68: 12, 0x90: 5, 0x91: 5, 0x92: 6, 0x93: 11, 0x94: 2, 0x95: 5}
+
+def main():
+  args = parse_args(sys.argv[1:])
+
+  try:
+    with open(args.vgm, 'rb') as file:
+      data = file.read()
+  except FileNotFoundError as e:
+    print(str(e))
+    exit(1)
+
+  #vgz is a gzipped vgm
+  if data[:2] == b'\x1f\x8b':
+    data = gzip.decompress(data)
+
+  if data[:4] != b'Vgm ':
+    print("NOT A VGM FILE")
+    exit(1)
+
+  try:
+    frames, loop_frame = parse_vgm(data, VGM_RATE // args.rate)
+  except ValueError as e:
+    print(str(e))
+    exit(1)
+
+  if args.no_loop:
+    loop_frame = None
+
+  stream = build_stream(frames, loop_frame)
+
+  write_header(args.header, args.name, stream)
+
+  print(f"{len(frames)} FRAMES, {len(stream)} BYTES")
+
+  exit(0)
+
+# parse vgm commands into a list of frames, each frame the sn writes made in it.
+def parse_vgm(data, samples_per_frame):
+  version = word32(data, 0x08)
+
+  data_offset = 0x40
+
+  if version >= 0x150 and word32(data, 0x34):
+    data_offset = 0x34 + word32(data, 0x34)
+
+  loop_offset = 0
+
+  if word32(data, 0x1C):
+    loop_offset = 0x1C + word32(data, 0x1C)
+
+  frames = [[]]
+  loop_frame = None
+  samples = 0
+  pos = data_offset
+
+  while pos < len(data):
+    #mark the frame the loop starts in
+    if pos == loop_offset:
+      loop_frame = samples // samples_per_frame
+
+    cmd = data[pos]
+
+    if cmd == 0x50:
+      frame_at(frames, samples // samples_per_frame).append(data[pos+1])
+      pos += 2
+    elif cmd == 0x61:
+      samples += data[pos+1] | (data[pos+2] << 8)
+      pos += 3
+    elif cmd == 0x62:
+      samples += 735
+      pos += 1
+    elif cmd == 0x63:
+      samples += 882
+      pos += 1
+    elif cmd == 0x66:
+      break
+    elif cmd == 0x67:
+      pos += CMD_SIZES[cmd] + word32(data, pos+3)
+    elif cmd in CMD_SIZES:
+      pos += CMD_SIZES[cmd]
+    elif 0x70 <= cmd <= 0x7F:
+      samples += (cmd & 0x0F) + 1
+      pos += 1
+    elif 0x80 <= cmd <= 0x8F:
+      samples += cmd & 0x0F
+      pos += 1
+    elif 0x30 <= cmd <= 0x3F:
+      pos += 2
+    elif 0x40 <= cmd <= 0x5F or 0xA0 <= cmd <= 0xBF:
+      pos += 3
+    elif 0xC0 <= cmd <= 0xDF:
+      pos += 4
+    elif 0xE0 <= cmd <= 0xFF:
+      pos += 5
+    else:
+      #size unknown, everything after it would be misread
+      raise ValueError(f"UNKNOWN VGM COMMAND 0x{cmd:02X} AT 0x{pos:X}")
+
+  frame_at(frames, samples // samples_per_frame)
+
+  return frames, loop_frame
+
+# get a frame, adding empty frames up to it.
+def frame_at(frames, index):
+  while len(frames) <= index:
+    frames.append([])
+
+  return frames[index]
+
+# run sn writes against register state. regs 0,2,4 are 10 bit tone, 1,3,5,7 attenuation, 6 noise.
+def apply_writes(regs, latch, writes):
+  for byte in writes:
+    if byte & 0x80:
+      latch = (byte >> 4) & 0x07
+
+      if latch in (0, 2, 4):
+        regs[latch] = (regs[latch] & 0x3F0) | (byte & 0x0F)
+      else:
+        regs[latch] = byte & 0x0F
+    elif latch in (0, 2, 4):
+      regs[latch] = (regs[latch] & 0x00F) | ((byte & 0x3F) << 4)
+    else:
+      regs[latch] = byte & 0x0F
+
+  return latch
+
+# smallest writes to move the chip from old register state to new.
+def delta(old, new, noise_written):
+  out = []
+
+  for reg in range(8):
+    if reg == 6:
+      #noise write restarts the shift register, keep every one made
+      if noise_written or old[6] != new[6]:
+        out.append(0x80 | (6 << 4) | new[6])
+      continue
+
+    if old[reg] == new[reg]:
+      continue
+
+    out.append(0x80 | (reg << 4) | (new[reg] & 0x0F))
+
+    #single latch byte when only the low nibble changed
+    if reg in (0, 2, 4) and (old[reg] & 0x3F0) != (new[reg] & 0x3F0):
+      out.append(0x40 | (new[reg] >> 4))
+
+  return out
+
+# build the stream, loop offset then frame deltas and waits.
+def build_stream(frames, loop_frame):
+  #tones 0, attenuation muted, until the vgm writes them
+  regs = [0, 15, 0, 15, 0, 15, 0, 15]
+  latch = 0
+  body = []
+  loop_offset = NO_LOOP
+  loop_regs = None
+  wait = 0
+
+  for index, writes in enumerate(frames):
+    new = list(regs)
+
+    latch = apply_writes(new, latch, writes)
+
+    noise_written = any((byte & 0xF0) == 0xE0 for byte in writes)
+
+    #the jump lands here with the registers as they were before this frame
+    if index == loop_frame:
+      body += wait_cmds(wait)
+      wait = 0
+      loop_offset = len(body)
+      loop_regs = list(regs)
+
+    #chip state is unknown at start, write every register on the first frame
+    if index == 0:
+      out = delta([-1] * 8, new, True)
+    else:
+      out = delta(regs, new, noise_written)
+
+    if out:
+      body += wait_cmds(wait)
+      wait = 0
+      body += out
+
+    wait += 1
+
+    regs = new
+
+  body += wait_cmds(wait)
+
+  #put the chip back to the state the loop started from before jumping
+  if loop_regs is not None:
+    body += delta(regs, loop_regs, False)
+
+  body.append(CMD_END)
+
+  return [loop_offset & 0xFF, loop_offset >> 8] + body
+
+# wait commands for a number of frames.
+def wait_cmds(frames):
+  out = []
+
+  while frames > 0:
+    out.append(min(frames, CMD_WAIT_MAX))
+    frames -= out[-1]
+
+  return out
+
+# write the stream as a C header.
+def write_header(path, name, stream):
+  lines = []
+
+  for index in range(0, len(stream), 16):
+    lines.append("  " + ", ".join(f"0x{byte:02X}" for byte in stream[index:index+16]))
+
+  try:
+    with open(path, 'w') as file:
+      file.write(f"/* generated by vgm2sn.py, {len(stream)} bytes */\n")
+      file.write(f"const uint8_t {name}[] =\n{{\n")
+      file.write(",\n".join(lines))
+      file.write("\n};\n")
+  except FileNotFoundError as e:
+    print(str(e))
+    exit(1)
+
+# little endian 32 bit word.
+def word32(data, pos):
+  return data[pos] | (data[pos+1] << 8) | (data[pos+2] << 16) | (data[pos+3] << 24)
+
+# parse args for tuning build
+def parse_args(argv):
+  parser = argparse.ArgumentParser(description='Convert a SN76489 VGM or VGZ file to a compact per frame register stream for the sn76489player.')
+
+  parser.add_argument('--vgm',     action='store',       default="music.vgm", dest='vgm',     required=False, help='VGM or VGZ file to convert.')
+  parser.add_argument('--header',  action='store',       default="music.h",   dest='header',  required=False, help='Location and name of header file to write.')
+  parser.add_argument('--name',    action='store',       default="c_music",   dest='name',    required=False, help='Name of the C array.')
+  parser.add_argument('--rate',    action='store',       default=60,          dest='rate',    required=False, type=int, help='Frames per second, 60 NTSC or 50 PAL.')
+  parser.add_argument('--no_loop', action='store_true',  default=False,       dest='no_loop', required=False, help='Ignore the VGM loop point and stop at the end.')
+
+  return parser.parse_args()
+
+# name is main is main
+if __name__=="__main__":
+  main()
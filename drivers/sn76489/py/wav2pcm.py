@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+################################################################################
+# @file   wav2pcm.py
+# @author Jay Convertino(jayconvertino@outlook.com)
+# @date   2026.10.19
+# @brief  Convert a WAV file to a sn76489pcm or gisndpcm sample in a C header.
+#
+# @license MIT
+# Copyright 2026 Jay Convertino
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to
+# deal in the Software without restriction, including without limitation the
+# rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+# sell copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+################################################################################
+import argparse
+import sys
+import wave
+import math
+
+#sample header, see sn76489pcm.h
+FORMAT_PACKED = 0
+FORMAT_DELTA  = 1
+RATE_IDS      = {4000:0, 8000:1}
+DELTA_CODES   = [-2, -1, 1, 2]
+MAX_BYTES     = 0xFFFF
+
+def main():
+  args = parse_args(sys.argv[1:])
+
+  try:
+    samples, rate = read_wav(args.wav)
+  except (FileNotFoundError, wave.Error) as e:
+    print(str(e))
+    exit(1)
+
+  samples = resample(samples, rate, args.rate)
+
+  amps = level_amps(args.chip)
+
+  levels = [nearest_level(amps, (sample + 1.0) / 2.0) for sample in normalize(samples)]
+
+  if args.format == "delta":
+    data, start = pack_delta(levels, amps)
+    fmt = FORMAT_DELTA
+  else:
+    data, start = pack_levels(levels)
+    fmt = FORMAT_PACKED
+
+  if len(data) > MAX_BYTES:
+    print("SAMPLE TOO LONG, " + str(len(data)) + " BYTES")
+    exit(1)
+
+  sample = [fmt | (start << 4), RATE_IDS[args.rate], len(data) & 0xFF, len(data) >> 8] + data
+
+  write_header(args.header, args.name, sample)
+
+  print(f"{len(levels)} SAMPLES, {len(sample)} BYTES")
+
+  exit(0)
+
+# read a wav as floats from -1 to 1, stereo is mixed to mono.
+def read_wav(path):
+  with wave.open(path, 'rb') as file:
+    channels = file.getnchannels()
+    width    = file.getsampwidth()
+    rate     = file.getframerate()
+    raw      = file.readframes(file.getnframes())
+
+  if width not in (1, 2):
+    raise wave.Error("ONLY 8 OR 16 BIT WAV FILES")
+
+  values = []
+
+  for index in range(0, len(raw), width):
+    if width == 1:
+      values.append((raw[index] - 128) / 128.0)
+    else:
+      values.append(int.from_bytes(raw[index:index+2], 'little', signed=True) / 32768.0)
+
+  mono = [sum(values[index:index+channels]) / channels for index in range(0, len(values), channels)]
+
+  return mono, rate
+
+# linear interpolation to the playback rate.
+def resample(samples, rate_in, rate_out):
+  if not samples:
+    return []
+
+  out = []
+
+  step = rate_in / rate_out
+
+  pos = 0.0
+
+  while pos < len(samples) - 1:
+    index = int(pos)
+    frac  = pos - index
+    out.append(samples[index] * (1.0 - frac) + samples[index+1] * frac)
+    pos += step
+
+  return out
+
+# scale to full range around the average.
+def normalize(samples):
+  if not samples:
+    return []
+
+  center = sum(samples) / len(samples)
+
+  peak = max(abs(sample - center) for sample in samples) or 1.0
+
+  return [(sample - center) / peak for sample in samples]
+
+# output amplitude of each chip value, sn is attenuation 2dB a step, gi is volume about 3dB a step.
+def level_amps(chip):
+  if chip == "gi":
+    return [0.0] + [math.pow(10.0, -(15 - value) * 3.0 / 20.0) for value in range(1, 16)]
+
+  return [math.pow(10.0, -value * 2.0 / 20.0) for value in range(0, 15)] + [0.0]
+
+# chip value closest to an amplitude from 0 to 1.
+def nearest_level(amps, amp):
+  return min(range(16), key=lambda value: abs(amps[value] - amp))
+
+# two levels a byte, high nibble first.
+def pack_levels(levels):
+  if len(levels) & 1:
+    levels = levels + [levels[-1]]
+
+  data = [(levels[index] << 4) | levels[index+1] for index in range(0, len(levels), 2)]
+
+  return data, levels[0] if levels else 0
+
+# four 2 bit deltas a byte, each picks the code landing closest to the wanted amplitude.
+def pack_delta(levels, amps):
+  start = levels[0] if levels else 0
+
+  level = start
+
+  codes = []
+
+  for want in levels:
+    best = None
+
+    for code, move in enumerate(DELTA_CODES):
+      value = min(max(level + move, 0), 15)
+
+      error = abs(amps[value] - amps[want])
+
+      if best is None or error < best[0]:
+        best = (error, code, value)
+
+    codes.append(best[1])
+
+    level = best[2]
+
+  while len(codes) & 3:
+    codes.append(codes[-1] if codes else 0)
+
+  data = [(codes[index] << 6) | (codes[index+1] << 4) | (codes[index+2] << 2) | codes[index+3] for index in range(0, len(codes), 4)]
+
+  return data, start
+
+# write the sample as a C header.
+def write_header(path, name, sample):
+  lines = []
+
+  for index in range(0, len(sample), 16):
+    lines.append("  " + ", ".join(f"0x{byte:02X}" for byte in sample[index:index+16]))
+
+  try:
+    with open(path, 'w') as file:
+      file.write(f"/* generated by wav2pcm.py, {len(sample)} bytes */\n")
+      file.write(f"const uint8_t {name}[] =\n{{\n")
+      file.write(",\n".join(lines))
+      file.write("\n};\n")
+  except FileNotFoundError as e:
+    print(str(e))
+    exit(1)
+
+# parse args for tuning build
+def parse_args(argv):
+  parser = argparse.ArgumentParser(description='Convert a WAV file to a 4 bit sample for sn76489pcm or gisndpcm playback.')
+
+  parser.add_argument('--wav',    action='store', default="sample.wav", dest='wav',    required=False, help='WAV file to convert, 8 or 16 bit, mono or stereo.')
+  parser.add_argument('--header', action='store', default="sample.h",   dest='header', required=False, help='Location and name of header file to write.')
+  parser.add_argument('--name',   action='store', default="c_sample",   dest='name',   required=False, help='Name of the C array.')
+  parser.add_argument('--chip',   action='store', default="sn",         dest='chip',   required=False, choices=["sn", "gi"], help='Chip the sample plays on, levels are chip values.')
+  parser.add_argument('--format', action='store', default="packed",     dest='format', required=False, choices=["packed", "delta"], help='packed is 2 samples a byte, delta is 4.')
+  parser.add_argument('--rate',   action='store', default=8000,         dest='rate',   required=False, type=int, choices=[4000, 8000], help='Playback rate.')
+
+  return parser.parse_args()
+
+# name is main is main
+if __name__=="__main__":
+  main()
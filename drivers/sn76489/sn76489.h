@@ -32,13 +32,102 @@
 
 #include <stdint.h>
 
+/** DEFINES **/
+/**
+ * @def SN_SND_CLK
+ * sound chip clock in hertz, set per target in the arch defines.h.
+ */
+#ifndef SN_SND_CLK
+#define SN_SND_CLK 3579545
+#endif
+/**
+ * @def SN_NOTES
+ * notes in the pitch table, 0 is C1, 95 is B8.
+ */
+#define SN_NOTES 96
+/**
+ * @def SN_FINE_STEPS
+ * fine tune steps per semitone, low 4 bits of a pitch.
+ */
+#define SN_FINE_STEPS 16
+/**
+ * @def SN_MAX_DIV
+ * largest tone divider, 10 bit, notes below about A2 clamp to it.
+ */
+#define SN_MAX_DIV 0x03FF
+/**
+ * @def SN_NOTE
+ * note from octave 1 to 8 and semitone 0 (C) to 11 (B).
+ */
+#define SN_NOTE(octave, semitone) ((uint8_t)(((octave) - 1) * 12 + (semitone)))
+/**
+ * @def SN_PITCH
+ * pitch from a note and a fine tune of 0 to SN_FINE_STEPS - 1, each step
+ * is 1/16 of a semitone up. Adding to a pitch is a linear musical slide.
+ */
+#define SN_PITCH(note, fine) ((uint16_t)(((uint16_t)(note) << 4) | ((fine) & 0x0F)))
+/**
+ * @def SN_FREQ_DIV
+ * tone divider from a clock and frequency in hertz, folds at compile time
+ * for constant arguments.
+ */
+#define SN_FREQ_DIV(refClk, voiceFreq) ((uint16_t)(((uint32_t)(refClk) / ((uint32_t)(voiceFreq) << 5)) & 0x03FF))
+
+/** DATA STRUCTURES **/
+/**
+ * @struct s_sn76489slide
+ * @brief Struct for a pitch slide, stepped once a frame.
+ */
+struct s_sn76489slide
+{
+  /**
+   * @var s_sn76489slide::pitch
+   * current pitch.
+   */
+  uint16_t pitch;
+  /**
+   * @var s_sn76489slide::target
+   * pitch the slide stops at.
+   */
+  uint16_t target;
+  /**
+   * @var s_sn76489slide::rate
+   * pitch steps per tick, 0 once the target is reached.
+   */
+  uint8_t rate;
+};
+
 /***************************************************************************//**
  * @brief   Initialize sn76489 to mute all channels
  ******************************************************************************/
 void initSN76489();
 
 /***************************************************************************//**
- * @brief   Calculate frequency from hertz to binary value.
+ * @brief   Hold setter writes in the register shadow until commitSN76489, so
+ *          several changes go out together with one interrupt disable.
+ * 
+ * @param   defer 1 to hold writes, 0 to commit and write on every set again.
+ ******************************************************************************/
+void setSN76489defer(uint8_t defer);
+
+/***************************************************************************//**
+ * @brief   Current defer state, so code run from the irq can hold writes and 
+ *          put the state back after.
+ * 
+ * @return  1 while writes are held, 0 otherwise.
+ ******************************************************************************/
+uint8_t getSN76489defer();
+
+/***************************************************************************//**
+ * @brief   Write registers that differ from what the chip holds. Tones only
+ *          send the data byte when the upper 6 bits changed. Interrupts are 
+ *          disabled once for the whole commit.
+ ******************************************************************************/
+void commitSN76489();
+
+/***************************************************************************//**
+ * @brief   Calculate frequency from hertz to binary value. Use SN_FREQ_DIV
+ *          for constants and getSN76489pitchDiv for notes.
  * 
  * @param   refClk is the reference clock in hertz for the sound chip.
  * @param   voiceFreq is the target frequency in hertz.
@@ -47,6 +136,36 @@ void initSN76489();
  ******************************************************************************/
 uint16_t getSN76489_FreqDiv(uint32_t refClk, uint32_t voiceFreq);
 
+/***************************************************************************//**
+ * @brief   Tone divider for a pitch from the note table, no division. The table
+ *          is built by the compiler for SN_SND_CLK, fine tune interpolates
+ *          to the next semitone and octaves shift with rounding.
+ * 
+ * @param   pitch SN_PITCH of a note and fine tune, clamps at the top note.
+ * 
+ * @return  Tone divider, clamped to SN_MAX_DIV.
+ ******************************************************************************/
+uint16_t getSN76489pitchDiv(uint16_t pitch);
+
+/***************************************************************************//**
+ * @brief   Start a pitch slide.
+ * 
+ * @param   p_slide pointer to struct to contain slide data.
+ * @param   from pitch to start at.
+ * @param   to pitch to stop at.
+ * @param   rate pitch steps per tick, SN_FINE_STEPS is a semitone a frame.
+ ******************************************************************************/
+void setSN76489slide(struct s_sn76489slide * const p_slide, uint16_t from, uint16_t to, uint8_t rate);
+
+/***************************************************************************//**
+ * @brief   Step a slide once, call once a frame.
+ * 
+ * @param   p_slide pointer to struct to contain slide data.
+ * 
+ * @return  Tone divider of the new pitch, 0 if p_slide is null.
+ ******************************************************************************/
+uint16_t tickSN76489slide(struct s_sn76489slide * const p_slide);
+
 /***************************************************************************//**
  * @brief   Set sn76489 voice frequency
  * 
@@ -55,6 +174,14 @@ uint16_t getSN76489_FreqDiv(uint32_t refClk, uint32_t voiceFreq);
  ******************************************************************************/
 void setSN76489voice_freq(uint8_t voice, uint16_t freqDiv);
 
+/***************************************************************************//**
+ * @brief   Set sn76489 voice to a pitch from the note table
+ * 
+ * @param   voice Select voice 1, 2, or 3.
+ * @param   pitch SN_PITCH of a note and fine tune.
+ ******************************************************************************/
+void setSN76489voice_pitch(uint8_t voice, uint16_t pitch);
+
 /***************************************************************************//**
  * @brief   Set sn76489 voice attenuation
  * 
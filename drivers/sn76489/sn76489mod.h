@@ -0,0 +1,287 @@
+/*******************************************************************************
+ * @file    sn76489mod.h
+ * @brief   Modulation engine for the sn76489 sound chip.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Software ADSR volume envelopes, vibrato and arpeggio tables, and 
+ *          pitch slides per channel, the sn76489 has no hardware envelope. 
+ *          Notes start from an instrument in ROM, tickSN76489mod is called 
+ *          once a frame from the vdp irq callback and steps every channel 
+ *          with adds and table lookups only, pitch goes through the driver 
+ *          note table. Writes go through the sn76489 register shadow and are
+ *          committed once per tick.
+ *
+ *          Envelope levels are 4.4 fixed point, rates are added or taken away
+ *          each frame, so 0x10 is one volume step a frame. Channel volume
+ *          is added as attenuation, about 2dB a step, no multiply.
+ *
+ * @version 0.0.1
+ *
+ * @license mit
+ *
+ * Copyright 2026 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_SN76489_MOD
+#define __LIB_SN76489_MOD
+
+#include <stdint.h>
+#include <sn76489.h>
+
+/** DEFINES **/
+/**
+ * @def SN_MOD_CHANNELS
+ * channels, 3 tone and noise. Noise only gets the volume envelope.
+ */
+#define SN_MOD_CHANNELS 4
+/**
+ * @def SN_MOD_NOISE_CHAN
+ * noise channel number.
+ */
+#define SN_MOD_NOISE_CHAN 3
+/**
+ * @def SN_MOD_NO_LOOP
+ * arpeggio loop value to hold the last entry.
+ */
+#define SN_MOD_NO_LOOP 0xFF
+/**
+ * @def SN_MOD_SINE_LEN
+ * entries in c_sn76489modSine.
+ */
+#define SN_MOD_SINE_LEN 16
+/**
+ * @def SN_MOD_OFF
+ * envelope stage, channel silent and idle.
+ */
+#define SN_MOD_OFF 0
+/**
+ * @def SN_MOD_ATTACK
+ * envelope stage, rising to full level.
+ */
+#define SN_MOD_ATTACK 1
+/**
+ * @def SN_MOD_DECAY
+ * envelope stage, falling to the sustain level.
+ */
+#define SN_MOD_DECAY 2
+/**
+ * @def SN_MOD_SUSTAIN
+ * envelope stage, held until note off.
+ */
+#define SN_MOD_SUSTAIN 3
+/**
+ * @def SN_MOD_RELEASE
+ * envelope stage, falling to silence.
+ */
+#define SN_MOD_RELEASE 4
+
+/** VIBRATO TABLE **/
+/**
+ * @var c_sn76489modSine
+ * one sine period of pitch offsets, +/- 8 fine steps (half a semitone).
+ */
+extern const int8_t c_sn76489modSine[];
+
+/** DATA STRUCTURES **/
+/**
+ * @struct s_sn76489modInst
+ * @brief Struct for an instrument, kept in ROM.
+ */
+struct s_sn76489modInst
+{
+  /**
+   * @var s_sn76489modInst::attack
+   * level added per frame, 0 starts at full level.
+   */
+  uint8_t attack;
+  /**
+   * @var s_sn76489modInst::decay
+   * level taken per frame down to sustain, 0 jumps to sustain.
+   */
+  uint8_t decay;
+  /**
+   * @var s_sn76489modInst::sustain
+   * sustain volume, 0 to 15.
+   */
+  uint8_t sustain;
+  /**
+   * @var s_sn76489modInst::release
+   * level taken per frame after note off, 0 is silent at once.
+   */
+  uint8_t release;
+  /**
+   * @var s_sn76489modInst::p_vibrato
+   * pitch offsets in fine steps, looped, 0 for none.
+   */
+  int8_t const *p_vibrato;
+  /**
+   * @var s_sn76489modInst::vibratoLen
+   * entries in p_vibrato.
+   */
+  uint8_t vibratoLen;
+  /**
+   * @var s_sn76489modInst::vibratoDelay
+   * frames after note on before vibrato starts.
+   */
+  uint8_t vibratoDelay;
+  /**
+   * @var s_sn76489modInst::p_arp
+   * semitone offsets, one per frame, 0 for none.
+   */
+  int8_t const *p_arp;
+  /**
+   * @var s_sn76489modInst::arpLen
+   * entries in p_arp.
+   */
+  uint8_t arpLen;
+  /**
+   * @var s_sn76489modInst::arpLoop
+   * entry to loop back to, SN_MOD_NO_LOOP holds the last entry.
+   */
+  uint8_t arpLoop;
+};
+
+/**
+ * @struct s_sn76489modChan
+ * @brief Struct for containing one channel.
+ */
+struct s_sn76489modChan
+{
+  /**
+   * @var s_sn76489modChan::p_inst
+   * instrument of the current note.
+   */
+  struct s_sn76489modInst const *p_inst;
+  /**
+   * @var s_sn76489modChan::slide
+   * note pitch, slides move it toward a target.
+   */
+  struct s_sn76489slide slide;
+  /**
+   * @var s_sn76489modChan::level
+   * envelope level, 4.4 fixed point.
+   */
+  uint8_t level;
+  /**
+   * @var s_sn76489modChan::volume
+   * channel volume, 0 to 15.
+   */
+  uint8_t volume;
+  /**
+   * @var s_sn76489modChan::stage
+   * SN_MOD_OFF to SN_MOD_RELEASE.
+   */
+  uint8_t stage;
+  /**
+   * @var s_sn76489modChan::vibratoPos
+   * next vibrato entry.
+   */
+  uint8_t vibratoPos;
+  /**
+   * @var s_sn76489modChan::vibratoWait
+   * frames left before vibrato starts.
+   */
+  uint8_t vibratoWait;
+  /**
+   * @var s_sn76489modChan::arpPos
+   * next arpeggio entry.
+   */
+  uint8_t arpPos;
+};
+
+/**
+ * @struct s_sn76489mod
+ * @brief Struct for containing modulation engine state.
+ */
+struct s_sn76489mod
+{
+  /**
+   * @var s_sn76489mod::chan
+   * state per channel.
+   */
+  struct s_sn76489modChan chan[SN_MOD_CHANNELS];
+};
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Initialize the engine with every channel off and full volume.
+ *
+ * @param   p_mod pointer to struct to contain engine data.
+ ******************************************************************************/
+void initSN76489mod(struct s_sn76489mod * const p_mod);
+
+/***************************************************************************//**
+ * @brief   Start a note, restarts the envelope and tables.
+ *
+ * @param   p_mod pointer to struct to contain engine data.
+ * @param   channel 0 to 2 tone, SN_MOD_NOISE_CHAN noise.
+ * @param   p_inst instrument, must stay valid while the note plays.
+ * @param   pitch SN_PITCH of the note, ignored for noise.
+ ******************************************************************************/
+void setSN76489modNoteOn(struct s_sn76489mod * const p_mod, uint8_t channel, struct s_sn76489modInst const * const p_inst, uint16_t pitch);
+
+/***************************************************************************//**
+ * @brief   Release a note, the envelope falls at the release rate.
+ *
+ * @param   p_mod pointer to struct to contain engine data.
+ * @param   channel 0 to 2 tone, SN_MOD_NOISE_CHAN noise.
+ ******************************************************************************/
+void setSN76489modNoteOff(struct s_sn76489mod * const p_mod, uint8_t channel);
+
+/***************************************************************************//**
+ * @brief   Slide the note pitch from where it is now.
+ *
+ * @param   p_mod pointer to struct to contain engine data.
+ * @param   channel 0 to 2 tone.
+ * @param   pitch SN_PITCH to stop at.
+ * @param   rate pitch steps per frame, SN_FINE_STEPS is a semitone a frame.
+ ******************************************************************************/
+void setSN76489modSlide(struct s_sn76489mod * const p_mod, uint8_t channel, uint16_t pitch, uint8_t rate);
+
+/***************************************************************************//**
+ * @brief   Set a channel volume, scales the envelope.
+ *
+ * @param   p_mod pointer to struct to contain engine data.
+ * @param   channel 0 to 2 tone, SN_MOD_NOISE_CHAN noise.
+ * @param   volume 0 silent to 15 full.
+ ******************************************************************************/
+void setSN76489modVolume(struct s_sn76489mod * const p_mod, uint8_t channel, uint8_t volume);
+
+/***************************************************************************//**
+ * @brief   Channels with a note sounding, including release.
+ *
+ * @param   p_mod pointer to struct to contain engine data.
+ * @return  channel bits, 0 when idle.
+ ******************************************************************************/
+uint8_t getSN76489modBusy(struct s_sn76489mod * const p_mod);
+
+/***************************************************************************//**
+ * @brief   Step every channel one frame and commit the sn76489 registers. 
+ *          Call once per frame from the vdp irq callback, writes are held
+ *          while it runs and committed after, unless main code was already
+ *          holding them, then they go out with its commit.
+ *
+ * @param   p_mod pointer to struct to contain engine data.
+ ******************************************************************************/
+void tickSN76489mod(struct s_sn76489mod * const p_mod);
+
+#endif
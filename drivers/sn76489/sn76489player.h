@@ -0,0 +1,204 @@
+/*******************************************************************************
+ * @file    sn76489player.h
+ * @brief   Music stream player for the sn76489 sound chip.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Plays register write streams made from VGM files by
+ *          py/vgm2sn.py. tickSN76489player is called once a frame from the 
+ *          vdp irq callback and runs at most SN_PLAYER_MAX_WRITES stream 
+ *          bytes, a frame with more carries over to the next tick so the time
+ *          spent in the irq is bounded. A latch and its tone data byte are
+ *          never split, and the ticks a frame carried over come off its wait
+ *          so the tempo holds. Stream bytes update a register image, the
+ *          registers they touched go to the sn76489 driver setters and one
+ *          commit writes what differs from its shadow, skipping channels an
+ *          effect has blocked. Main code should leave the chip alone while a
+ *          stream plays.
+ *
+ *          Stream format, little endian 16 bit loop offset from the first
+ *          command (0xFFFF for no loop) followed by commands:
+ *            - 0x80 to 0xFF, latch byte as the chip takes it.
+ *            - 0x40 to 0x7F, tone data byte as the chip takes it (bit 6 is 
+ *              ignored by the chip).
+ *            - 0x01 to 0x3F, end of frame, wait that many frames.
+ *            - 0x00, end of stream, jump to the loop or stop.
+ *
+ * @version 0.0.1
+ *
+ * @license mit
+ *
+ * Copyright 2026 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_SN76489_PLAYER
+#define __LIB_SN76489_PLAYER
+
+#include <stdint.h>
+
+/** DEFINES **/
+/**
+ * @def SN_PLAYER_MAX_WRITES
+ * most stream writes per tick, one more when a tone data byte follows the
+ * last latch.
+ */
+#ifndef SN_PLAYER_MAX_WRITES
+#define SN_PLAYER_MAX_WRITES 8
+#endif
+/**
+ * @def SN_PLAYER_NO_LOOP
+ * loop offset for a stream that stops at its end.
+ */
+#define SN_PLAYER_NO_LOOP 0xFFFF
+/**
+ * @def SN_PLAYER_END
+ * end of stream command.
+ */
+#define SN_PLAYER_END 0x00
+/**
+ * @def SN_PLAYER_WAIT_MAX
+ * largest wait command, frames.
+ */
+#define SN_PLAYER_WAIT_MAX 0x3F
+/**
+ * @def SN_PLAYER_DATA
+ * lowest tone data byte command.
+ */
+#define SN_PLAYER_DATA 0x40
+/**
+ * @def SN_PLAYER_REGS
+ * chip registers, tone and attenuation for each voice, noise control and 
+ * noise attenuation. Register r belongs to channel r >> 1, noise is 3.
+ */
+#define SN_PLAYER_REGS 8
+/**
+ * @def SN_PLAYER_NOISE_REG
+ * noise control register.
+ */
+#define SN_PLAYER_NOISE_REG 6
+/**
+ * @def SN_PLAYER_ALL
+ * dirty bits for every register.
+ */
+#define SN_PLAYER_ALL 0xFF
+
+/** DATA STRUCTURES **/
+/**
+ * @struct s_sn76489player
+ * @brief Struct for containing stream player state.
+ */
+struct s_sn76489player
+{
+  /**
+   * @var s_sn76489player::p_stream
+   * first command of the stream.
+   */
+  uint8_t const *p_stream;
+  /**
+   * @var s_sn76489player::p_pos
+   * next command to run.
+   */
+  uint8_t const *p_pos;
+  /**
+   * @var s_sn76489player::p_loop
+   * command to jump to at the end, 0 for none.
+   */
+  uint8_t const *p_loop;
+  /**
+   * @var s_sn76489player::regs
+   * music register image, 10 bit tones, 4 bit the rest.
+   */
+  uint16_t regs[SN_PLAYER_REGS];
+  /**
+   * @var s_sn76489player::dirty
+   * register bits changed since they went to the driver, a dirty noise
+   * control restarts the noise.
+   */
+  uint8_t dirty;
+  /**
+   * @var s_sn76489player::latch
+   * register the stream last latched.
+   */
+  uint8_t latch;
+  /**
+   * @var s_sn76489player::blocked
+   * channel bits (0 to 3) owned by effects, not written by the player.
+   */
+  uint8_t blocked;
+  /**
+   * @var s_sn76489player::wait
+   * frames left before the next command.
+   */
+  uint8_t wait;
+  /**
+   * @var s_sn76489player::carry
+   * extra ticks frames have carried over, taken off the next wait.
+   */
+  uint8_t carry;
+  /**
+   * @var s_sn76489player::playing
+   * 1 while the stream is running.
+   */
+  uint8_t playing;
+};
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Initialize the player with a stream, stopped. The player also holds
+ *          the music image the effect manager gives channels back to, pass 0
+ *          for no music.
+ *
+ * @param   p_player pointer to struct to contain player data.
+ * @param   p_data stream made by py/vgm2sn.py, loop offset first, or 0.
+ ******************************************************************************/
+void initSN76489player(struct s_sn76489player * const p_player, uint8_t const * const p_data);
+
+/***************************************************************************//**
+ * @brief   Start the stream from the beginning.
+ *
+ * @param   p_player pointer to struct to contain player data.
+ ******************************************************************************/
+void setSN76489playerPlay(struct s_sn76489player * const p_player);
+
+/***************************************************************************//**
+ * @brief   Stop the stream and mute all channels.
+ *
+ * @param   p_player pointer to struct to contain player data.
+ ******************************************************************************/
+void setSN76489playerStop(struct s_sn76489player * const p_player);
+
+/***************************************************************************//**
+ * @brief   Check if the stream is still playing.
+ *
+ * @param   p_player pointer to struct to contain player data.
+ * @return  0 when stopped, 1 when playing.
+ ******************************************************************************/
+uint8_t getSN76489playerBusy(struct s_sn76489player * const p_player);
+
+/***************************************************************************//**
+ * @brief   Run one frame of the stream and write changed registers. Call once
+ *          per frame from the vdp irq callback, also when stopped.
+ *
+ * @param   p_player pointer to struct to contain player data.
+ ******************************************************************************/
+void tickSN76489player(struct s_sn76489player * const p_player);
+
+#endif
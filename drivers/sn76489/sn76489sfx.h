@@ -0,0 +1,177 @@
+/*******************************************************************************
+ * @file    sn76489sfx.h
+ * @brief   Sound effect manager for the sn76489 sound chip.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Plays effects on top of a sn76489player. Each effect picks a free
+ *          channel from its channel mask, taking it from the music if needed,
+ *          or steals one from an effect of the same or lower priority. The
+ *          music keeps running in its register image while blocked and is
+ *          written back when the effect ends. tickSN76489sfx is called once
+ *          a frame from the vdp irq callback, after tickSN76489player.
+ *
+ *          Effect format, shared with gisndsfx:
+ *            - byte 0 frames, byte 1 priority (higher wins), byte 2 channel 
+ *              mask (bits 0 to 2 tone, bit 3 noise).
+ *            - then per frame, level (0 to 15, 15 loudest) or'd with the
+ *              SN_SFX_* flags, divider low byte, divider high nibble with the
+ *              noise setting in the upper nibble.
+ *          Dividers are the same on both chips at their usual clocks, 
+ *          f = 111861 / divider.
+ *
+ * @version 0.0.1
+ *
+ * @license mit
+ *
+ * Copyright 2026 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_SN76489_SFX
+#define __LIB_SN76489_SFX
+
+#include <stdint.h>
+#include <sn76489player.h>
+
+/** DEFINES **/
+/**
+ * @def SN_SFX_CHANNELS
+ * channels effects can use, 3 tone and noise.
+ */
+#define SN_SFX_CHANNELS 4
+/**
+ * @def SN_SFX_NOISE_CHAN
+ * noise channel number.
+ */
+#define SN_SFX_NOISE_CHAN 3
+/**
+ * @def SN_SFX_NONE
+ * no channel.
+ */
+#define SN_SFX_NONE 0xFF
+/**
+ * @def SN_SFX_HEADER
+ * bytes before the first frame.
+ */
+#define SN_SFX_HEADER 3
+/**
+ * @def SN_SFX_STEP
+ * bytes per frame.
+ */
+#define SN_SFX_STEP 3
+/**
+ * @def SN_SFX_NOISE
+ * frame flag, write the noise setting (noise channel only, type << 2 | rate).
+ */
+#define SN_SFX_NOISE 0x10
+/**
+ * @def SN_SFX_TONE_OFF
+ * frame flag, tone silent for the frame.
+ */
+#define SN_SFX_TONE_OFF 0x20
+
+/** DATA STRUCTURES **/
+/**
+ * @struct s_sn76489sfxVoice
+ * @brief Struct for containing one effect channel.
+ */
+struct s_sn76489sfxVoice
+{
+  /**
+   * @var s_sn76489sfxVoice::p_pos
+   * next frame of the effect, 0 when idle.
+   */
+  uint8_t const *p_pos;
+  /**
+   * @var s_sn76489sfxVoice::frames
+   * frames left.
+   */
+  uint8_t frames;
+  /**
+   * @var s_sn76489sfxVoice::priority
+   * priority of the running effect.
+   */
+  uint8_t priority;
+};
+
+/**
+ * @struct s_sn76489sfx
+ * @brief Struct for containing effect manager state.
+ */
+struct s_sn76489sfx
+{
+  /**
+   * @var s_sn76489sfx::p_music
+   * player holding the music image channels go back to.
+   */
+  struct s_sn76489player *p_music;
+  /**
+   * @var s_sn76489sfx::voice
+   * effect state per channel.
+   */
+  struct s_sn76489sfxVoice voice[SN_SFX_CHANNELS];
+};
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Initialize the effect manager.
+ *
+ * @param   p_sfx pointer to struct to contain effect data.
+ * @param   p_music player to share the chip with, initialized even if no 
+ *          music plays. Must stay valid.
+ ******************************************************************************/
+void initSN76489sfx(struct s_sn76489sfx * const p_sfx, struct s_sn76489player * const p_music);
+
+/***************************************************************************//**
+ * @brief   Start an effect on a channel from its mask.
+ *
+ * @param   p_sfx pointer to struct to contain effect data.
+ * @param   p_effect effect data, see file details.
+ * @return  channel used, SN_SFX_NONE if every allowed channel has a higher 
+ *          priority effect.
+ ******************************************************************************/
+uint8_t setSN76489sfxPlay(struct s_sn76489sfx * const p_sfx, uint8_t const * const p_effect);
+
+/***************************************************************************//**
+ * @brief   Stop the effect on a channel and give it back to the music.
+ *
+ * @param   p_sfx pointer to struct to contain effect data.
+ * @param   channel channel returned by setSN76489sfxPlay.
+ ******************************************************************************/
+void setSN76489sfxStop(struct s_sn76489sfx * const p_sfx, uint8_t channel);
+
+/***************************************************************************//**
+ * @brief   Channels with effects running.
+ *
+ * @param   p_sfx pointer to struct to contain effect data.
+ * @return  channel bits, 0 when idle.
+ ******************************************************************************/
+uint8_t getSN76489sfxBusy(struct s_sn76489sfx * const p_sfx);
+
+/***************************************************************************//**
+ * @brief   Step all effects one frame. Call once per frame from the vdp irq
+ *          callback after tickSN76489player.
+ *
+ * @param   p_sfx pointer to struct to contain effect data.
+ ******************************************************************************/
+void tickSN76489sfx(struct s_sn76489sfx * const p_sfx);
+
+#endif
@@ -44,14 +44,34 @@
 #define FIRST_BYTE  0x80
 #define SECOND_BYTE 0x00
 #define REG_SHIFT   4
+#define NUM_REGS    8
+#define TONE_LOW    0x000F
+#define TONE_HIGH   0x03F0
+#define UNKNOWN     0xFFFF
+
+/** REGISTER SHADOW **/
+/*** registers as set, tones 10 bit ***/
+static uint16_t regImage[NUM_REGS] = {0, 15, 0, 15, 0, 15, 0, 15};
+/*** registers as the chip holds them, unknown until first written ***/
+static uint16_t regShadow[NUM_REGS] = {UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN};
+/*** noise control writes restart the noise, write even if unchanged ***/
+static uint8_t noiseTrigger = 0;
+/*** hold writes until commit ***/
+static uint8_t deferWrite = 0;
 
 /** SEE MY PRIVATES **/
 /*** send data to port and control chip ***/
 inline void sendData(uint8_t data);
+/*** store a register in the image, write it unless deferred ***/
+static void setImage(uint8_t reg, uint16_t data);
 
 /*** Initialize sn76489 ***/
 void initSN76489()
 {
+  uint8_t defer = deferWrite;
+
+  deferWrite = 1;
+
   /**** mute all ****/
   
   setSN76489voice_attn(1, 15);
@@ -61,12 +81,165 @@ void initSN76489()
   setSN76489voice_attn(3, 15);
   
   setSN76489noise_attn(15);
+
+  deferWrite = defer;
+
+  if(!deferWrite) commitSN76489();
+}
+
+/*** hold writes ***/
+void setSN76489defer(uint8_t defer)
+{
+  deferWrite = defer;
+
+  if(!deferWrite) commitSN76489();
+}
+
+/*** defer state ***/
+uint8_t getSN76489defer()
+{
+  return deferWrite;
+}
+
+/*** write changed registers ***/
+void commitSN76489()
+{
+  uint8_t  reg = 0;
+  uint16_t data = 0;
+  uint16_t shadow = 0;
+
+  vdp_lock();
+
+  for(reg = 0; reg < NUM_REGS; reg++)
+  {
+    data = regImage[reg];
+
+    shadow = regShadow[reg];
+
+    if(reg == NOISE_CTRL)
+    {
+      if((data == shadow) && !noiseTrigger) continue;
+
+      noiseTrigger = 0;
+    }
+    else if(data == shadow)
+    {
+      continue;
+    }
+
+    regShadow[reg] = data;
+
+    sendData(((unsigned)reg << REG_SHIFT) | (data & TONE_LOW) | FIRST_BYTE);
+
+    /**** single latch byte when only the low nibble of a tone changed ****/
+    if((reg < NOISE_CTRL) && !(reg & 1) && ((data ^ shadow) & TONE_HIGH))
+    {
+      sendData((((data & TONE_HIGH) >> 4) | SECOND_BYTE));
+    }
+  }
+
+  vdp_unlock();
 }
 
 /*** calculate freqDiv ***/
 uint16_t getSN76489_FreqDiv(uint32_t refClk, uint32_t voiceFreq)
 {
-  return (refClk/(voiceFreq << 5)) & 0x03FF;
+  return SN_FREQ_DIV(refClk, voiceFreq);
+}
+
+/** PITCH TABLE **/
+/*** clock scaled for dividers from millihertz, clk * 1000 / 32 ***/
+#define NOTE_CLK ((uint32_t)SN_SND_CLK * 125 / 4)
+/*** divider for a note in millihertz, folded by the compiler ***/
+#define NOTE_DIV(milliHz) (uint16_t)((NOTE_CLK + ((milliHz) >> 1)) / (milliHz))
+
+/*** C0 to C1, octave 0 keeps an extra bit for the rounding shift ***/
+static const uint16_t c_noteDiv[13] =
+{
+  NOTE_DIV(16352), NOTE_DIV(17324), NOTE_DIV(18354), NOTE_DIV(19445),
+  NOTE_DIV(20602), NOTE_DIV(21827), NOTE_DIV(23125), NOTE_DIV(24500),
+  NOTE_DIV(25957), NOTE_DIV(27500), NOTE_DIV(29135), NOTE_DIV(30868),
+  NOTE_DIV(32703)
+};
+
+/*** pitch to divider ***/
+uint16_t getSN76489pitchDiv(uint16_t pitch)
+{
+  uint8_t note = 0;
+  uint8_t fine = 0;
+  uint8_t shift = 1;
+  uint16_t step = 0;
+  uint16_t sum = 0;
+  uint16_t div = 0;
+
+  if(pitch > SN_PITCH(SN_NOTES - 1, 0)) pitch = SN_PITCH(SN_NOTES - 1, 0);
+
+  note = (uint8_t)(pitch >> 4);
+
+  fine = (uint8_t)pitch & 0x0F;
+
+  for(; note >= 12; note -= 12) shift++;
+
+  div = c_noteDiv[note];
+
+  /**** fine tune moves toward the next semitone, shift and add multiply ****/
+  step = div - c_noteDiv[note + 1];
+
+  if(fine & 0x01) sum += step;
+  if(fine & 0x02) sum += step << 1;
+  if(fine & 0x04) sum += step << 2;
+  if(fine & 0x08) sum += step << 3;
+
+  div -= sum >> 4;
+
+  /**** round the shifted bits ****/
+  div = (div + (1 << (shift - 1))) >> shift;
+
+  return (div > SN_MAX_DIV ? SN_MAX_DIV : div);
+}
+
+/*** start a slide ***/
+void setSN76489slide(struct s_sn76489slide * const p_slide, uint16_t from, uint16_t to, uint8_t rate)
+{
+  /**** NULL Check ****/
+  if(!p_slide) return;
+
+  p_slide->pitch = from;
+
+  p_slide->target = to;
+
+  p_slide->rate = (from == to ? 0 : rate);
+}
+
+/*** step a slide ***/
+uint16_t tickSN76489slide(struct s_sn76489slide * const p_slide)
+{
+  uint16_t left = 0;
+
+  /**** NULL Check ****/
+  if(!p_slide) return 0;
+
+  if(p_slide->rate)
+  {
+    left = (p_slide->pitch < p_slide->target ? p_slide->target - p_slide->pitch : p_slide->pitch - p_slide->target);
+
+    if(left <= p_slide->rate)
+    {
+      p_slide->pitch = p_slide->target;
+
+      p_slide->rate = 0;
+    }
+    else if(p_slide->pitch < p_slide->target)
+    {
+      p_slide->pitch += p_slide->rate;
+    }
+    else
+    {
+      p_slide->pitch -= p_slide->rate;
+    }
+  }
+
+  return getSN76489pitchDiv(p_slide->pitch);
 }
 
 /** SET YOUR DATA **/
@@ -93,8 +266,13 @@ void setSN76489voice_freq(uint8_t voice, uint16_t freqDiv)
       break;
   }
   
-  sendData((((unsigned)regVoice << REG_SHIFT) | (freqDiv & 0x000F) | FIRST_BYTE));
-  sendData((((freqDiv & 0x03F0) >> 4) | SECOND_BYTE));
+  setImage(regVoice, freqDiv & 0x03FF);
+}
+
+/*** set sn76489 voice pitch ***/
+void setSN76489voice_pitch(uint8_t voice, uint16_t pitch)
+{
+  setSN76489voice_freq(voice, getSN76489pitchDiv(pitch));
 }
 
 /*** set sn76489 voice attenuation ***/
@@ -119,27 +297,33 @@ void setSN76489voice_attn(uint8_t voice, uint8_t attenuate)
       break;
   }
   
-  sendData(((unsigned)regVoice << REG_SHIFT) | attenuate | FIRST_BYTE);
+  setImage(regVoice, attenuate & 0x0F);
 }
 
 /*** set sn76489 noise attenuation ***/
 void setSN76489noise_attn(uint8_t attenuate)
 {
-  sendData(((unsigned)NOISE_ATTN << REG_SHIFT) | attenuate | FIRST_BYTE);
+  setImage(NOISE_ATTN, attenuate & 0x0F);
 }
 
 /*** set sn76489 noise controls***/
 void setSN76489noiseCtrl(uint8_t type, uint8_t rate)
 {
-  sendData(((unsigned)NOISE_CTRL << REG_SHIFT) | (unsigned)rate | ((unsigned)type << 2) | FIRST_BYTE);
+  noiseTrigger = 1;
+
+  setImage(NOISE_CTRL, (rate & 0x03) | ((type & 0x01) << 2));
+}
+
+/*** store a register in the image, write it unless deferred ***/
+static void setImage(uint8_t reg, uint16_t data)
+{
+  regImage[reg] = data;
+
+  if(!deferWrite) commitSN76489();
 }
 
-/*** send data to chip ***/
+/*** send data to chip, caller holds interrupts off ***/
 inline void sendData(uint8_t data)
 {
-  di();
-  
   SN_SND_PORT = data;
-  
-  ei();
 }
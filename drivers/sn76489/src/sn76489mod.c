@@ -0,0 +1,312 @@
+/*******************************************************************************
+ * @file    sn76489mod.c
+ * @brief   Modulation engine for the sn76489 sound chip.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details ADSR, vibrato, arpeggio, and slides stepped once a frame.
+ *
+ * @license mit
+ *
+ * Copyright 2026 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <base.h>
+#include <stdint.h>
+
+#include <sn76489.h>
+#include <sn76489mod.h>
+
+/** DEFINES **/
+#define LEVEL_MAX     0xF0
+#define LEVEL_SHIFT   4
+#define ATTN_MUTE     15
+
+/** VIBRATO TABLE **/
+/*** one period, half a semitone each way ***/
+const int8_t c_sn76489modSine[SN_MOD_SINE_LEN] =
+{
+  0, 3, 6, 7, 8, 7, 6, 3, 0, -3, -6, -7, -8, -7, -6, -3
+};
+
+/** SEE MY PRIVATES **/
+/*** step the envelope of a channel ***/
+static void tickModEnvelope(struct s_sn76489modChan * const p_chan);
+/*** divider with slide, arpeggio, and vibrato applied ***/
+static uint16_t tickModDiv(struct s_sn76489modChan * const p_chan);
+
+/** INITIALIZE AND FREE MY STRUCTS **/
+
+/*** Initialize modulation engine ***/
+void initSN76489mod(struct s_sn76489mod * const p_mod)
+{
+  uint8_t index = 0;
+
+  /**** NULL Check ****/
+  if(!p_mod) return;
+
+  for(index = 0; index < SN_MOD_CHANNELS; index++)
+  {
+    p_mod->chan[index].p_inst = 0;
+    p_mod->chan[index].level = 0;
+    p_mod->chan[index].volume = 15;
+    p_mod->chan[index].stage = SN_MOD_OFF;
+    p_mod->chan[index].vibratoPos = 0;
+    p_mod->chan[index].vibratoWait = 0;
+    p_mod->chan[index].arpPos = 0;
+
+    setSN76489slide(&p_mod->chan[index].slide, 0, 0, 0);
+  }
+}
+
+/** SET YOUR DATA **/
+
+/*** start a note ***/
+void setSN76489modNoteOn(struct s_sn76489mod * const p_mod, uint8_t channel, struct s_sn76489modInst const * const p_inst, uint16_t pitch)
+{
+  struct s_sn76489modChan *p_chan = 0;
+
+  /**** NULL Check ****/
+  if(!p_mod) return;
+
+  if(!p_inst) return;
+
+  if(channel >= SN_MOD_CHANNELS) return;
+
+  p_chan = &p_mod->chan[channel];
+
+  vdp_lock();
+
+  p_chan->p_inst = p_inst;
+
+  p_chan->level = 0;
+
+  p_chan->stage = SN_MOD_ATTACK;
+
+  p_chan->vibratoPos = 0;
+
+  p_chan->vibratoWait = p_inst->vibratoDelay;
+
+  p_chan->arpPos = 0;
+
+  setSN76489slide(&p_chan->slide, pitch, pitch, 0);
+
+  vdp_unlock();
+}
+
+/*** release a note ***/
+void setSN76489modNoteOff(struct s_sn76489mod * const p_mod, uint8_t channel)
+{
+  /**** NULL Check ****/
+  if(!p_mod) return;
+
+  if(channel >= SN_MOD_CHANNELS) return;
+
+  vdp_lock();
+
+  if(p_mod->chan[channel].stage != SN_MOD_OFF) p_mod->chan[channel].stage = SN_MOD_RELEASE;
+
+  vdp_unlock();
+}
+
+/*** slide from the current pitch ***/
+void setSN76489modSlide(struct s_sn76489mod * const p_mod, uint8_t channel, uint16_t pitch, uint8_t rate)
+{
+  struct s_sn76489slide *p_slide = 0;
+
+  /**** NULL Check ****/
+  if(!p_mod) return;
+
+  if(channel >= SN_MOD_NOISE_CHAN) return;
+
+  p_slide = &p_mod->chan[channel].slide;
+
+  vdp_lock();
+
+  setSN76489slide(p_slide, p_slide->pitch, pitch, rate);
+
+  vdp_unlock();
+}
+
+/*** channel volume ***/
+void setSN76489modVolume(struct s_sn76489mod * const p_mod, uint8_t channel, uint8_t volume)
+{
+  /**** NULL Check ****/
+  if(!p_mod) return;
+
+  if(channel >= SN_MOD_CHANNELS) return;
+
+  p_mod->chan[channel].volume = volume & 0x0F;
+}
+
+/** GET YOUR DATA **/
+
+/*** channels sounding ***/
+uint8_t getSN76489modBusy(struct s_sn76489mod * const p_mod)
+{
+  uint8_t index = 0;
+  uint8_t busy = 0;
+
+  /**** NULL Check ****/
+  if(!p_mod) return 0;
+
+  for(index = 0; index < SN_MOD_CHANNELS; index++)
+  {
+    if(p_mod->chan[index].stage != SN_MOD_OFF) busy |= (1 << index);
+  }
+
+  return busy;
+}
+
+/** TICK **/
+
+/*** step every channel, one commit for the frame ***/
+void tickSN76489mod(struct s_sn76489mod * const p_mod)
+{
+  uint8_t index = 0;
+  uint8_t attn = 0;
+  uint8_t defer = 0;
+  struct s_sn76489modChan *p_chan = 0;
+
+  /**** NULL Check ****/
+  if(!p_mod) return;
+
+  /**** main code may be holding writes, leave them held for its commit ****/
+  defer = getSN76489defer();
+
+  setSN76489defer(1);
+
+  for(index = 0; index < SN_MOD_CHANNELS; index++)
+  {
+    p_chan = &p_mod->chan[index];
+
+    if(p_chan->stage == SN_MOD_OFF) continue;
+
+    tickModEnvelope(p_chan);
+
+    /**** attenuations add, so the volume scales the envelope without a multiply ****/
+    attn = (ATTN_MUTE - (p_chan->level >> LEVEL_SHIFT)) + (ATTN_MUTE - p_chan->volume);
+
+    if(attn > ATTN_MUTE) attn = ATTN_MUTE;
+
+    if(index == SN_MOD_NOISE_CHAN)
+    {
+      setSN76489noise_attn(attn);
+
+      continue;
+    }
+
+    setSN76489voice_freq(index + 1, tickModDiv(p_chan));
+
+    setSN76489voice_attn(index + 1, attn);
+  }
+
+  if(!defer) setSN76489defer(0);
+}
+
+/*** step the envelope of a channel ***/
+static void tickModEnvelope(struct s_sn76489modChan * const p_chan)
+{
+  uint8_t sustain = p_chan->p_inst->sustain << LEVEL_SHIFT;
+
+  switch(p_chan->stage)
+  {
+    case SN_MOD_ATTACK:
+      if(!p_chan->p_inst->attack || (LEVEL_MAX - p_chan->level <= p_chan->p_inst->attack))
+      {
+        p_chan->level = LEVEL_MAX;
+
+        p_chan->stage = SN_MOD_DECAY;
+      }
+      else
+      {
+        p_chan->level += p_chan->p_inst->attack;
+      }
+      break;
+    case SN_MOD_DECAY:
+      if(!p_chan->p_inst->decay || (p_chan->level <= sustain) || (p_chan->level - sustain <= p_chan->p_inst->decay))
+      {
+        p_chan->level = sustain;
+
+        p_chan->stage = SN_MOD_SUSTAIN;
+      }
+      else
+      {
+        p_chan->level -= p_chan->p_inst->decay;
+      }
+      break;
+    case SN_MOD_RELEASE:
+      if(!p_chan->p_inst->release || (p_chan->level <= p_chan->p_inst->release))
+      {
+        p_chan->level = 0;
+
+        p_chan->stage = SN_MOD_OFF;
+      }
+      else
+      {
+        p_chan->level -= p_chan->p_inst->release;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+/*** divider with slide, arpeggio, and vibrato applied ***/
+static uint16_t tickModDiv(struct s_sn76489modChan * const p_chan)
+{
+  int16_t pitch = 0;
+  int16_t offset = 0;
+  uint16_t div = 0;
+  struct s_sn76489modInst const *p_inst = p_chan->p_inst;
+
+  div = tickSN76489slide(&p_chan->slide);
+
+  if(p_inst->p_arp && p_inst->arpLen)
+  {
+    offset += (int16_t)p_inst->p_arp[p_chan->arpPos] * SN_FINE_STEPS;
+
+    if(++p_chan->arpPos >= p_inst->arpLen)
+    {
+      p_chan->arpPos = (p_inst->arpLoop >= p_inst->arpLen ? p_inst->arpLen - 1 : p_inst->arpLoop);
+    }
+  }
+
+  if(p_inst->p_vibrato && p_inst->vibratoLen)
+  {
+    if(p_chan->vibratoWait)
+    {
+      p_chan->vibratoWait--;
+    }
+    else
+    {
+      offset += p_inst->p_vibrato[p_chan->vibratoPos];
+
+      if(++p_chan->vibratoPos >= p_inst->vibratoLen) p_chan->vibratoPos = 0;
+    }
+  }
+
+  /**** the slide already looked up its divider, only an offset pitch needs another ****/
+  if(!offset) return div;
+
+  pitch = (int16_t)p_chan->slide.pitch + offset;
+
+  return getSN76489pitchDiv(pitch < 0 ? 0 : (uint16_t)pitch);
+}
@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * @file    sn76489pcm.c
+ * @brief   Sample playback for the sn76489 sound chip.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Voice setup around the shared pcm.h loops, levels go out latched.
+ *
+ * @license mit
+ *
+ * Copyright 2026 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <base.h>
+#include <stdint.h>
+
+#include <sn76489.h>
+#include <sn76489pcm.h>
+
+/** DEFINES **/
+#define LATCH_BIT     0x80
+#define REG_SHIFT     4
+#define ATTN_MUTE     15
+
+/** SET YOUR DATA **/
+
+/*** play a sample ***/
+void setSN76489pcmPlay(uint8_t voice, uint8_t const * const p_sample, uint8_t const * const p_vram, uint16_t vramSize)
+{
+  uint8_t level = 0;
+  uint8_t latch = 0;
+
+  /**** NULL Check ****/
+  if(!p_sample) return;
+
+  if((voice < 1) || (voice > 3)) return;
+
+  level = setPCMsample(p_sample, p_vram, vramSize);
+
+  if(level == PCM_INVALID) return;
+
+  latch = LATCH_BIT | ((((voice - 1) << 1) + 1) << REG_SHIFT);
+
+  /**** tone at divider 1 is a flat level, the attenuation is the sample ****/
+  setSN76489voice_freq(voice, 1);
+
+  setSN76489voice_attn(voice, level);
+
+  commitSN76489();
+
+  /**** the lock holds the vdp nmi, di holds the spinner irq ****/
+  vdp_lock();
+
+  di();
+
+  playPCM(SN_SND_ADDR, latch);
+
+  /**** the shadow missed the loop writes, mute on the chip then in the image ****/
+  SN_SND_PORT = latch | ATTN_MUTE;
+
+  ei();
+
+  vdp_unlock();
+
+  setSN76489voice_attn(voice, ATTN_MUTE);
+}
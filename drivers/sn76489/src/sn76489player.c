@@ -0,0 +1,310 @@
+/*******************************************************************************
+ * @file    sn76489player.c
+ * @brief   Music stream player for the sn76489 sound chip.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Runs a VGM derived register write stream once a frame.
+ *
+ * @license mit
+ *
+ * Copyright 2026 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <base.h>
+#include <stdint.h>
+
+#include <sn76489.h>
+#include <sn76489player.h>
+
+/** DEFINES **/
+#define LATCH_BIT   0x80
+#define REG_SHIFT   4
+#define TONE_LOW    0x000F
+#define TONE_HIGH   0x03F0
+#define ATTN_MUTE   15
+#define ATTN_REGS   0xAA
+
+/** SEE MY PRIVATES **/
+/*** mute the music image ***/
+static void setPlayerMute(struct s_sn76489player * const p_player);
+/*** hand dirty image registers to the driver ***/
+static void commitPlayerRegs(struct s_sn76489player * const p_player);
+
+/** INITIALIZE AND FREE MY STRUCTS **/
+
+/*** Initialize the player ***/
+void initSN76489player(struct s_sn76489player * const p_player, uint8_t const * const p_data)
+{
+  uint8_t  index = 0;
+  uint16_t loop = 0;
+
+  /**** NULL Check ****/
+  if(!p_player) return;
+
+  p_player->playing = 0;
+
+  p_player->wait = 0;
+
+  p_player->carry = 0;
+
+  p_player->p_stream = 0;
+
+  p_player->p_pos = 0;
+
+  p_player->p_loop = 0;
+
+  p_player->latch = 0;
+
+  p_player->blocked = 0;
+
+  /**** muted image, all dirty so the first commit hands everything over ****/
+  p_player->dirty = SN_PLAYER_ALL;
+
+  for(index = 0; index < SN_PLAYER_REGS; index++)
+  {
+    p_player->regs[index] = (index & 1 ? ATTN_MUTE : 0);
+  }
+
+  if(!p_data) return;
+
+  loop = (uint16_t)p_data[0] | ((uint16_t)p_data[1] << 8);
+
+  p_player->p_stream = p_data + 2;
+
+  p_player->p_pos = p_player->p_stream;
+
+  if(loop != SN_PLAYER_NO_LOOP) p_player->p_loop = p_player->p_stream + loop;
+}
+
+/** SET YOUR DATA **/
+
+/*** start the stream ***/
+void setSN76489playerPlay(struct s_sn76489player * const p_player)
+{
+  /**** NULL Check ****/
+  if(!p_player) return;
+
+  if(!p_player->p_stream) return;
+
+  vdp_lock();
+
+  p_player->p_pos = p_player->p_stream;
+
+  p_player->wait = 0;
+
+  p_player->carry = 0;
+
+  p_player->playing = 1;
+
+  vdp_unlock();
+}
+
+/*** stop the stream ***/
+void setSN76489playerStop(struct s_sn76489player * const p_player)
+{
+  /**** NULL Check ****/
+  if(!p_player) return;
+
+  vdp_lock();
+
+  p_player->playing = 0;
+
+  setPlayerMute(p_player);
+
+  vdp_unlock();
+}
+
+/** GET YOUR DATA **/
+
+/*** check if playing ***/
+uint8_t getSN76489playerBusy(struct s_sn76489player * const p_player)
+{
+  /**** NULL Check ****/
+  if(!p_player) return 0;
+
+  return p_player->playing;
+}
+
+/** TICK **/
+
+/*** run one frame of the stream ***/
+void tickSN76489player(struct s_sn76489player * const p_player)
+{
+  uint8_t writes = 0;
+  uint8_t command = 0;
+  uint8_t latch = 0;
+  uint8_t const *p_pos = 0;
+
+  /**** NULL Check ****/
+  if(!p_player) return;
+
+  /**** stopped or waiting, still restore channels effects give back ****/
+  if(!p_player->playing || (p_player->wait && --p_player->wait))
+  {
+    commitPlayerRegs(p_player);
+
+    return;
+  }
+
+  p_pos = p_player->p_pos;
+
+  latch = p_player->latch;
+
+  for(;;)
+  {
+    command = *p_pos;
+
+    /**** out of writes at the next latch, tone data bytes stay with theirs and waits cost nothing ****/
+    if((writes >= SN_PLAYER_MAX_WRITES) && (command & LATCH_BIT))
+    {
+      p_player->carry++;
+
+      break;
+    }
+
+    p_pos++;
+
+    if(command >= SN_PLAYER_DATA)
+    {
+      writes++;
+
+      if(command & LATCH_BIT)
+      {
+        latch = (command >> REG_SHIFT) & 0x07;
+
+        /**** latch carries the low 4 bits of any register ****/
+        p_player->regs[latch] = ((latch < SN_PLAYER_NOISE_REG) && !(latch & 1) ? (p_player->regs[latch] & TONE_HIGH) : 0) | (command & TONE_LOW);
+      }
+      else if((latch < SN_PLAYER_NOISE_REG) && !(latch & 1))
+      {
+        p_player->regs[latch] = (p_player->regs[latch] & TONE_LOW) | ((uint16_t)(command & 0x3F) << 4);
+      }
+      else
+      {
+        p_player->regs[latch] = command & TONE_LOW;
+      }
+
+      p_player->dirty |= (1 << latch);
+
+      continue;
+    }
+
+    if(command != SN_PLAYER_END)
+    {
+      /**** ticks spent finishing long frames come off this wait, 1 is the next tick ****/
+      if(command > p_player->carry)
+      {
+        p_player->wait = command - p_player->carry;
+
+        p_player->carry = 0;
+      }
+      else
+      {
+        p_player->carry -= command - 1;
+
+        p_player->wait = 1;
+      }
+
+      break;
+    }
+
+    if(!p_player->p_loop)
+    {
+      p_player->playing = 0;
+
+      setPlayerMute(p_player);
+
+      break;
+    }
+
+    p_pos = p_player->p_loop;
+  }
+
+  /**** out of writes, wait stays 0 so the frame finishes next tick ****/
+  p_player->p_pos = p_pos;
+
+  p_player->latch = latch;
+
+  commitPlayerRegs(p_player);
+}
+
+/*** mute the music image ***/
+static void setPlayerMute(struct s_sn76489player * const p_player)
+{
+  uint8_t index = 0;
+
+  for(index = 1; index < SN_PLAYER_REGS; index += 2)
+  {
+    p_player->regs[index] = ATTN_MUTE;
+  }
+
+  p_player->dirty |= ATTN_REGS;
+}
+
+/*** hand dirty image registers to the driver, one commit, already in the irq ***/
+static void commitPlayerRegs(struct s_sn76489player * const p_player)
+{
+  uint8_t  index = 0;
+  uint8_t  defer = 0;
+  uint16_t data = 0;
+
+  if(!p_player->dirty) return;
+
+  /**** main code may be holding writes, leave them held for its commit ****/
+  defer = getSN76489defer();
+
+  setSN76489defer(1);
+
+  for(index = 0; index < SN_PLAYER_REGS; index++)
+  {
+    if(!(p_player->dirty & (1 << index))) continue;
+
+    /**** effect owns this channel, stays dirty for when it gives it back ****/
+    if(p_player->blocked & (1 << (index >> 1))) continue;
+
+    p_player->dirty &= ~(1 << index);
+
+    data = p_player->regs[index];
+
+    /**** register r is voice (r >> 1) + 1, noise is the last pair ****/
+    switch(index)
+    {
+      case SN_PLAYER_NOISE_REG:
+        setSN76489noiseCtrl((data >> 2) & 0x01, data & 0x03);
+        break;
+      case SN_PLAYER_NOISE_REG + 1:
+        setSN76489noise_attn((uint8_t)data);
+        break;
+      default:
+        if(index & 1)
+        {
+          setSN76489voice_attn((index >> 1) + 1, (uint8_t)data);
+        }
+        else
+        {
+          setSN76489voice_freq((index >> 1) + 1, data);
+        }
+        break;
+    }
+  }
+
+  if(!defer) setSN76489defer(0);
+}
@@ -0,0 +1,244 @@
+/*******************************************************************************
+ * @file    sn76489sfx.c
+ * @brief   Sound effect manager for the sn76489 sound chip.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Priority channel allocation over the music player image.
+ *
+ * @license mit
+ *
+ * Copyright 2026 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <base.h>
+#include <stdint.h>
+
+#include <sn76489.h>
+#include <sn76489sfx.h>
+
+/** DEFINES **/
+#define SFX_FRAMES    0
+#define SFX_PRIORITY  1
+#define SFX_MASK      2
+#define LEVEL_MASK    0x0F
+#define ATTN_MUTE     15
+
+/** SEE MY PRIVATES **/
+/*** end the effect on a channel, music takes it back on its next tick ***/
+static void setSFXrelease(struct s_sn76489sfx * const p_sfx, uint8_t channel);
+
+/** INITIALIZE AND FREE MY STRUCTS **/
+
+/*** Initialize effect manager ***/
+void initSN76489sfx(struct s_sn76489sfx * const p_sfx, struct s_sn76489player * const p_music)
+{
+  uint8_t index = 0;
+
+  /**** NULL Check ****/
+  if(!p_sfx) return;
+
+  p_sfx->p_music = p_music;
+
+  for(index = 0; index < SN_SFX_CHANNELS; index++)
+  {
+    p_sfx->voice[index].p_pos = 0;
+    p_sfx->voice[index].frames = 0;
+    p_sfx->voice[index].priority = 0;
+  }
+}
+
+/** SET YOUR DATA **/
+
+/*** start an effect ***/
+uint8_t setSN76489sfxPlay(struct s_sn76489sfx * const p_sfx, uint8_t const * const p_effect)
+{
+  uint8_t index = 0;
+  uint8_t channel = SN_SFX_NONE;
+  uint8_t priority = 0;
+  struct s_sn76489sfxVoice *p_voice = 0;
+
+  /**** NULL Check ****/
+  if(!p_sfx) return SN_SFX_NONE;
+
+  if(!p_sfx->p_music) return SN_SFX_NONE;
+
+  if(!p_effect) return SN_SFX_NONE;
+
+  if(!p_effect[SFX_FRAMES]) return SN_SFX_NONE;
+
+  priority = p_effect[SFX_PRIORITY];
+
+  vdp_lock();
+
+  /**** free channel first, music always yields, else the lowest priority effect not above ours ****/
+  for(index = 0; index < SN_SFX_CHANNELS; index++)
+  {
+    if(!(p_effect[SFX_MASK] & (1 << index))) continue;
+
+    p_voice = &p_sfx->voice[index];
+
+    if(!p_voice->p_pos)
+    {
+      channel = index;
+
+      break;
+    }
+
+    if((p_voice->priority <= priority) && ((channel == SN_SFX_NONE) || (p_voice->priority < p_sfx->voice[channel].priority)))
+    {
+      channel = index;
+    }
+  }
+
+  if(channel != SN_SFX_NONE)
+  {
+    p_voice = &p_sfx->voice[channel];
+
+    p_voice->frames = p_effect[SFX_FRAMES];
+
+    p_voice->priority = priority;
+
+    p_voice->p_pos = p_effect + SN_SFX_HEADER;
+
+    p_sfx->p_music->blocked |= (1 << channel);
+  }
+
+  vdp_unlock();
+
+  return channel;
+}
+
+/*** stop an effect ***/
+void setSN76489sfxStop(struct s_sn76489sfx * const p_sfx, uint8_t channel)
+{
+  /**** NULL Check ****/
+  if(!p_sfx) return;
+
+  if(channel >= SN_SFX_CHANNELS) return;
+
+  vdp_lock();
+
+  setSFXrelease(p_sfx, channel);
+
+  vdp_unlock();
+}
+
+/** GET YOUR DATA **/
+
+/*** channels with effects ***/
+uint8_t getSN76489sfxBusy(struct s_sn76489sfx * const p_sfx)
+{
+  uint8_t index = 0;
+  uint8_t busy = 0;
+
+  /**** NULL Check ****/
+  if(!p_sfx) return 0;
+
+  for(index = 0; index < SN_SFX_CHANNELS; index++)
+  {
+    if(p_sfx->voice[index].p_pos) busy |= (1 << index);
+  }
+
+  return busy;
+}
+
+/** TICK **/
+
+/*** step effects through the driver image, one commit, already in the irq ***/
+void tickSN76489sfx(struct s_sn76489sfx * const p_sfx)
+{
+  uint8_t  index = 0;
+  uint8_t  level = 0;
+  uint8_t  attn = 0;
+  uint8_t  noise = 0;
+  uint8_t  defer = 0;
+  uint16_t divider = 0;
+  struct s_sn76489sfxVoice *p_voice = 0;
+
+  /**** NULL Check ****/
+  if(!p_sfx) return;
+
+  if(!p_sfx->p_music) return;
+
+  /**** main code may be holding writes, leave them held for its commit ****/
+  defer = getSN76489defer();
+
+  setSN76489defer(1);
+
+  for(index = 0; index < SN_SFX_CHANNELS; index++)
+  {
+    p_voice = &p_sfx->voice[index];
+
+    if(!p_voice->p_pos) continue;
+
+    if(!p_voice->frames)
+    {
+      setSFXrelease(p_sfx, index);
+
+      continue;
+    }
+
+    p_voice->frames--;
+
+    level = p_voice->p_pos[0];
+
+    /**** chip takes 10 bits ****/
+    divider = ((uint16_t)p_voice->p_pos[1] | ((uint16_t)p_voice->p_pos[2] << 8)) & 0x03FF;
+
+    noise = (p_voice->p_pos[2] >> 4) & 0x07;
+
+    p_voice->p_pos += SN_SFX_STEP;
+
+    /**** the driver shadow tracks the chip, so only changes are written ****/
+    attn = ((level & SN_SFX_TONE_OFF) ? ATTN_MUTE : ATTN_MUTE - (level & LEVEL_MASK));
+
+    if(index == SN_SFX_NOISE_CHAN)
+    {
+      /**** every noise write restarts the noise, only on request ****/
+      if(level & SN_SFX_NOISE) setSN76489noiseCtrl((noise >> 2) & 0x01, noise & 0x03);
+
+      setSN76489noise_attn(attn);
+
+      continue;
+    }
+
+    setSN76489voice_freq(index + 1, divider);
+
+    setSN76489voice_attn(index + 1, attn);
+  }
+
+  if(!defer) setSN76489defer(0);
+}
+
+/*** end the effect on a channel, music takes it back on its next tick ***/
+static void setSFXrelease(struct s_sn76489sfx * const p_sfx, uint8_t channel)
+{
+  p_sfx->voice[channel].p_pos = 0;
+
+  p_sfx->voice[channel].frames = 0;
+
+  p_sfx->voice[channel].priority = 0;
+
+  p_sfx->p_music->blocked &= ~(1 << channel);
+
+  /**** effect left its own values in the driver, hand the music pair back ****/
+  p_sfx->p_music->dirty |= (0x03 << (channel << 1));
+}
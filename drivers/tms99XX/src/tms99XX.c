@@ -33,6 +33,25 @@
 
 #include <tms99XX.h>
 
+/** DEFINES **/
+/*** largest fast fill between status polls, 128 blocks of 8 ***/
+#define FAST_CHUNK_SIZE 1024
+/*** march element cells per call of the asm loop, one page ***/
+#define MARCH_PAGE_SIZE 256
+/*** glyphs styled per burst between status polls, about the time of a fast chunk ***/
+#define FONT_BATCH_GLYPHS 16
+
+/** FAST TRANSFER DATA, used by the asm loops **/
+static uint8_t fastData;
+static uint8_t fastRem;
+static uint8_t fastBlocks;
+static uint8_t fastFail;
+static uint8_t fastActual;
+static uint8_t fastWrite;
+static uint8_t fastDown;
+static uint16_t fastCount;
+static uint8_t *p_fastData;
+
 /** SEE MY PRIVATES **/
 /*** read VDP status register ***/
 inline uint8_t readVDPstatus(struct s_tms99XX * const p_tms99XX);
@@ -46,6 +65,44 @@ inline void writeVDPvramAddr(struct s_tms99XX * const p_tms99XX, uint16_t addres
 inline void writeVDPregister(struct s_tms99XX * const p_tms99XX, uint8_t regNum, uint8_t data);
 /*** graphics mode ***/
 inline void initVDPmode(struct s_tms99XX * const p_tms99XX);
+/*** fill VDP vram at full bandwidth, display must be blanked ***/
+static void fillVDPvramFast(struct s_tms99XX * const p_tms99XX, uint16_t address, uint8_t data, uint16_t size);
+/*** unrolled out loop for fillVDPvramFast ***/
+static void fastVDPfill(void) __naked;
+/*** check VDP vram against a constant at full bandwidth, display must be blanked ***/
+static uint8_t verifyVDPvramFast(struct s_tms99XX * const p_tms99XX, uint16_t address, uint8_t data, uint16_t size, struct s_tms99XX_vramTest *p_result, uint8_t stage);
+/*** unrolled in and compare loop for verifyVDPvramFast ***/
+static void fastVDPverify(void) __naked;
+/*** one march element over all vram ***/
+static uint8_t marchVDPvram(struct s_tms99XX * const p_tms99XX, uint8_t readData, uint8_t writeData, uint8_t down, struct s_tms99XX_vramTest *p_result);
+/*** read check then write each cell of one page ***/
+static void fastVDPmarch(void) __naked;
+/*** address in address test over all vram ***/
+static uint8_t addrVDPvram(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_vramTest *p_result);
+/*** write one 256 byte page of address in address data ***/
+static void fastVDPaddrWrite(void) __naked;
+/*** check one 256 byte page of address in address data ***/
+static void fastVDPaddrVerify(void) __naked;
+/*** store a vram test failure ***/
+inline void setVDPtestResult(struct s_tms99XX_vramTest *p_result, uint16_t address, uint8_t expected, uint8_t actual, uint8_t stage);
+/*** write VDP vram at full bandwidth, display must be blanked or in vblank ***/
+static void writeVDPvramFast(struct s_tms99XX * const p_tms99XX, uint16_t address, uint8_t const *p_data, uint16_t size);
+/*** unrolled outi loop for writeVDPvramFast ***/
+static void fastVDPwrite(void) __naked;
+/*** style and write glyphs for setTMS99XXfont ***/
+static void fastVDPfont(void) __naked;
+/*** read VDP vram at full bandwidth, display must be blanked or in vblank ***/
+static void readVDPvramFast(struct s_tms99XX * const p_tms99XX, uint16_t address, uint8_t *p_data, uint16_t size);
+/*** unrolled ini loop for readVDPvramFast ***/
+static void fastVDPread(void) __naked;
+/*** start and size of each table the current mode uses ***/
+static uint8_t getVDPtables(struct s_tms99XX * const p_tms99XX, uint16_t *p_start, uint16_t *p_size);
+/*** move a snapshot, all names then GFX II patterns and colors by runs ***/
+static void moveVDPsnapshot(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_snapshot * const p_snap, uint8_t restore);
+/*** move one block of vram to or from the snapshot store ***/
+static void moveVDPsegment(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_snapshot * const p_snap, uint16_t address, uint16_t size, uint8_t restore);
+/*** move a snapshot, blanked when it is too big for a vblank ***/
+static void moveVDPsnapshotSafe(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_snapshot * const p_snap, uint8_t restore);
 
 /** INITIALIZE AND FREE MY STRUCTS **/
 
@@ -66,6 +123,13 @@ void initTMS99XX(struct s_tms99XX *p_tms99XX, uint8_t vdpMode, uint8_t backColor
 
   p_tms99XX->colorReg = (unsigned char)(backColor & 0x0F);
 
+  /**** count frames till first unblank ****/
+  p_tms99XX->bootFrames = 0;
+
+  p_tms99XX->bootCount = frameCount;
+
+  p_tms99XX->bootTiming = 1;
+
   /**** set vdp addresses ****/
   p_tms99XX->nameTableAddr = NAME_TABLE_ADDR;
 
@@ -81,6 +145,55 @@ void initTMS99XX(struct s_tms99XX *p_tms99XX, uint8_t vdpMode, uint8_t backColor
   initVDPmode(p_tms99XX);
 }
 
+/*** Initialize only the VRAM tables used by the current mode. ***/
+void initTMS99XXvram(struct s_tms99XX * const p_tms99XX)
+{
+  uint8_t prevRegister1;
+
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+
+  prevRegister1 = p_tms99XX->register1;
+
+  /**** blank so the fill can run at full bandwidth ****/
+  setTMS99XXblank(p_tms99XX, 1);
+
+  switch(p_tms99XX->vdpMode)
+  {
+    case TXT_MODE:
+      fillVDPvramFast(p_tms99XX, p_tms99XX->nameTableAddr, 0, NAME_TABLE_TXT_SIZE);
+      fillVDPvramFast(p_tms99XX, p_tms99XX->patternTableAddr, 0, PATTERN_TABLE_SIZE);
+      break;
+    case GFXII_MODE:
+      fillVDPvramFast(p_tms99XX, p_tms99XX->nameTableAddr, 0, NAME_TABLE_SIZE);
+      fillVDPvramFast(p_tms99XX, p_tms99XX->patternTableAddr, 0, PATTERN_TABLE_GFXII_SIZE);
+      fillVDPvramFast(p_tms99XX, p_tms99XX->colorTableAddr, 0, COLOR_TABLE_GFXII_SIZE);
+      break;
+    case BMP_MODE:
+      fillVDPvramFast(p_tms99XX, p_tms99XX->nameTableAddr, 0, NAME_TABLE_SIZE);
+      fillVDPvramFast(p_tms99XX, p_tms99XX->patternTableAddr, 0, PATTERN_TABLE_BMP_SIZE);
+      break;
+    default:
+      fillVDPvramFast(p_tms99XX, p_tms99XX->nameTableAddr, 0, NAME_TABLE_SIZE);
+      fillVDPvramFast(p_tms99XX, p_tms99XX->patternTableAddr, 0, PATTERN_TABLE_SIZE);
+      fillVDPvramFast(p_tms99XX, p_tms99XX->colorTableAddr, 0, COLOR_TABLE_SIZE);
+      break;
+  }
+
+  /**** text mode has no sprites, all others stop at sprite 0 ****/
+  if(p_tms99XX->vdpMode != TXT_MODE)
+  {
+    fillVDPvramFast(p_tms99XX, p_tms99XX->spriteAttributeAddr, 0, SPRITE_ATTRIBUTE_TABLE_SIZE);
+
+    setTMS99XXvramSpriteTerm(p_tms99XX, 0);
+  }
+
+  /**** restore blank state ****/
+  p_tms99XX->register1 = prevRegister1;
+
+  writeVDPregister(p_tms99XX, REGISTER_1, p_tms99XX->register1);
+}
+
 /*** Set the TMS99XX mode to one of 4. Text, Graphics I, Graphics II, and bitmap. ***/
 void setTMS99XXmode(struct s_tms99XX * const p_tms99XX, uint8_t vdpMode)
 {
@@ -106,6 +219,14 @@ void setTMS99XXblank(struct s_tms99XX * const p_tms99XX, uint8_t mode)
   else
   {
     p_tms99XX->register1 |= (uint8_t)(1 << BLK_SCRN_BIT);
+
+    /**** first unblank ends boot timing, catch the last irq frames and frame flag ****/
+    if(p_tms99XX->bootTiming)
+    {
+      readVDPstatus(p_tms99XX);
+
+      p_tms99XX->bootTiming = 0;
+    }
   }
 
   writeVDPregister(p_tms99XX, REGISTER_1, p_tms99XX->register1);
@@ -204,6 +325,65 @@ int setTMS99XXvramTableData(struct s_tms99XX * const p_tms99XX, uint16_t tableAd
   return writeVDPvram(p_tms99XX, (uint8_t *)p_data, size * number, size * number);
 }
 
+/*** upload glyphs to the pattern table with a style applied ***/
+void setTMS99XXfont(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_font const * const p_font, uint8_t first, uint16_t number, uint8_t slot, uint8_t style)
+{
+  uint8_t  count = 0;
+  uint8_t const *p_glyph = 0;
+
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+
+  if(!p_font) return;
+
+  /**** clip the range to the characters in the font ****/
+  if(first < p_font->first) return;
+
+  first -= p_font->first;
+
+  if(first >= p_font->number) return;
+
+  if(number > (uint16_t)(p_font->number - first)) number = p_font->number - first;
+
+  p_glyph = p_font->p_data + (uint16_t)first * p_font->rows;
+
+  /**** full height and no style, burst straight from ROM ****/
+  if((style == FONT_PLAIN) && (p_font->rows == 8))
+  {
+    writeVDPvramFast(p_tms99XX, p_tms99XX->patternTableAddr + ((uint16_t)slot << 3), p_glyph, number << 3);
+
+    return;
+  }
+
+  /**** style is applied in the out loop, rows past the stored ones pad with 0 ****/
+  fastData = style;
+
+  fastRem = (uint8_t)(8 - (p_font->rows > 8 ? 8 : p_font->rows));
+
+  p_fastData = (uint8_t *)p_glyph;
+
+  writeVDPvramAddr(p_tms99XX, p_tms99XX->patternTableAddr + ((uint16_t)slot << 3), 0);
+
+  for(; number > 0; number -= count)
+  {
+    count = (uint8_t)(number > FONT_BATCH_GLYPHS ? FONT_BATCH_GLYPHS : number);
+
+    fastBlocks = count;
+
+    /**** address and p_fastData keep incrementing between bursts ****/
+    vdp_lock();
+
+    fastVDPfont();
+
+    vdp_move((uint16_t)count << 3);
+
+    /**** poll status between bursts like the plain path ****/
+    readVDPstatus(p_tms99XX);
+
+    vdp_unlock();
+  }
+}
+
 /*** Set the start of the write VRAM address. After this is set writes will auto increment the address. ***/
 void setTMS99XXvramWriteAddr(struct s_tms99XX * const p_tms99XX, uint16_t vramAddr)
 {
@@ -248,7 +428,7 @@ void setTMS99XXvramSpriteTerm(struct s_tms99XX * const p_tms99XX, uint8_t const
 
   spriteTerm.dataNibbles.colorCode = TMS_TRANSPARENT;
 
-  writeVDPvramAddr(p_tms99XX, p_tms99XX->spriteAttributeAddr + (num * sizeof(spriteTerm)), 1);
+  writeVDPvramAddr(p_tms99XX, p_tms99XX->spriteAttributeAddr + (num * sizeof(spriteTerm)), 0);
 
   /**** no need to check return, plenty of time to write 4 bytes ****/
   writeVDPvram(p_tms99XX, (uint8_t const * const)&spriteTerm, sizeof(spriteTerm), sizeof(spriteTerm));
@@ -266,61 +446,284 @@ uint8_t getTMS99XXstatus(struct s_tms99XX * const p_tms99XX)
   return readVDPstatus(p_tms99XX);
 }
 
-/*** clear data from VRAM. ***/
-void clearTMS99XXvramData(struct s_tms99XX * const p_tms99XX)
+/*** Frames from init to first unblank. ***/
+uint16_t getTMS99XXbootFrames(struct s_tms99XX * const p_tms99XX)
 {
-  int      index = 0;
-  uint8_t  data = 0x00;
-  uint16_t amtWrote = 0;
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
 
-  /**** set start address to write 0x00 to all of the VRAM ****/
-  writeVDPvramAddr(p_tms99XX, 0x0000, 0);
+  return p_tms99XX->bootFrames;
+}
+
+/*** largest block of vram the current mode does not use ***/
+uint16_t getTMS99XXfreeVram(struct s_tms99XX * const p_tms99XX, uint16_t *p_addr)
+{
+  uint8_t  index = 0;
+  uint8_t  sort = 0;
+  uint8_t  number = 0;
+  uint16_t temp = 0;
+  uint16_t end = 0;
+  uint16_t freeSize = 0;
+  uint16_t start[5];
+  uint16_t size[5];
+
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+
+  number = getVDPtables(p_tms99XX, start, size);
 
-  for(index = 0; index < MEM_SIZE; index += amtWrote)
+  /**** insertion sort tables by start address ****/
+  for(index = 1; index < number; index++)
   {
-    amtWrote = (uint16_t)writeVDPvram(p_tms99XX, &data, MEM_SIZE - index, 1);
+    for(sort = index; (sort > 0) && (start[sort - 1] > start[sort]); sort--)
+    {
+      temp = start[sort];
+      start[sort] = start[sort - 1];
+      start[sort - 1] = temp;
+
+      temp = size[sort];
+      size[sort] = size[sort - 1];
+      size[sort - 1] = temp;
+    }
   }
+
+  /**** check the gap before each table, then the gap to the end of vram ****/
+  for(index = 0; index <= number; index++)
+  {
+    temp = (index < number ? start[index] : MEM_SIZE);
+
+    if((temp > end) && ((uint16_t)(temp - end) > freeSize))
+    {
+      freeSize = temp - end;
+
+      if(p_addr) *p_addr = end;
+    }
+
+    /**** tables can overlap, keep the furthest end ****/
+    if((index < number) && (start[index] + size[index] > end)) end = start[index] + size[index];
+  }
+
+  return freeSize;
+}
+
+/*** bytes needed for a snapshot ***/
+uint16_t getTMS99XXsnapshotSize(struct s_tms99XX * const p_tms99XX, uint8_t width, uint8_t height)
+{
+  uint16_t cells = (uint16_t)width * height;
+
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+
+  /**** name, plus 8 pattern and 8 color bytes in GFX II ****/
+  return (p_tms99XX->vdpMode == GFXII_MODE ? cells * 17 : cells);
+}
+
+/*** save a name table region ***/
+uint8_t getTMS99XXsnapshot(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_snapshot * const p_snap, uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t *p_buffer, uint16_t size)
+{
+  uint16_t needed = 0;
+  uint16_t freeAddr = 0;
+
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+
+  if(!p_snap) return 0;
+
+  /**** region must be on screen ****/
+  if((uint16_t)x + width > (p_tms99XX->vdpMode == TXT_MODE ? NAME_TABLE_TXT_COLS : NAME_TABLE_COLS)) return 0;
+
+  if((uint16_t)y + height > NAME_TABLE_ROWS) return 0;
+
+  needed = getTMS99XXsnapshotSize(p_tms99XX, width, height);
+
+  if(!needed) return 0;
+
+  /**** no RAM buffer, use spare vram if there is enough ****/
+  if(!p_buffer)
+  {
+    size = getTMS99XXfreeVram(p_tms99XX, &freeAddr);
+  }
+
+  if(size < needed) return 0;
+
+  p_snap->p_buffer = p_buffer;
+  p_snap->vramAddr = freeAddr;
+  p_snap->size = needed;
+  p_snap->x = x;
+  p_snap->y = y;
+  p_snap->width = width;
+  p_snap->height = height;
+
+  moveVDPsnapshotSafe(p_tms99XX, p_snap, 0);
+
+  return 1;
+}
+
+/*** restore a name table region ***/
+void setTMS99XXsnapshot(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_snapshot * const p_snap)
+{
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+
+  if(!p_snap) return;
+
+  if(!p_snap->size) return;
+
+  moveVDPsnapshotSafe(p_tms99XX, p_snap, 1);
+}
+
+/*** clear data from VRAM. ***/
+void clearTMS99XXvramData(struct s_tms99XX * const p_tms99XX)
+{
+  uint8_t prevRegister1;
+
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+
+  prevRegister1 = p_tms99XX->register1;
+
+  setTMS99XXblank(p_tms99XX, 1);
+
+  /**** write 0x00 to all of the VRAM ****/
+  fillVDPvramFast(p_tms99XX, 0x0000, 0x00, MEM_SIZE);
+
+  p_tms99XX->register1 = prevRegister1;
+
+  writeVDPregister(p_tms99XX, REGISTER_1, p_tms99XX->register1);
 }
 
 /*** check vram with read write check ***/
 uint8_t checkTMS99XXvram(struct s_tms99XX * const p_tms99XX)
 {
-  /**** future improvemtn, crc check of some sort ****/
-  int      index = 0;
-  uint16_t bufIndex = 0;
-  uint8_t  buffer[256] = {0};
-  uint8_t  data = 0x55;
-  uint16_t amtRead = 0;
-  uint16_t amtWrote = 0;
+  return testTMS99XXvram(p_tms99XX, VRAM_TEST_QUICK, 0);
+}
 
-  /**** set start address to write 0x55 to all of the VRAM ****/
-  writeVDPvramAddr(p_tms99XX, 0x0000, 0);
+/*** test vram with address in address and march tests ***/
+uint8_t testTMS99XXvram(struct s_tms99XX * const p_tms99XX, uint8_t coverage, struct s_tms99XX_vramTest *p_result)
+{
+  uint8_t index = 0;
+  uint8_t pass = 0;
+  uint8_t prevRegister1;
+
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
 
-  for(index = 0; index < MEM_SIZE; index += amtWrote)
+  prevRegister1 = p_tms99XX->register1;
+
+  /**** blank so the test can run at full bandwidth ****/
+  setTMS99XXblank(p_tms99XX, 1);
+
+  /**** address lines first, a bad address line makes the march results meaningless ****/
+  pass = addrVDPvram(p_tms99XX, p_result);
+
+  if(coverage == VRAM_TEST_QUICK)
   {
-    amtWrote = (uint16_t)writeVDPvram(p_tms99XX, &data, MEM_SIZE - index, 1);
-  }
+    /**** w0, up r0w1, down r1w0, r0 ****/
+    if(pass)
+    {
+      fillVDPvramFast(p_tms99XX, 0x0000, 0x00, MEM_SIZE);
 
-  /**** reset address to 0 for read ****/
-  writeVDPvramAddr(p_tms99XX, 0x0000, 1);
+      pass = marchVDPvram(p_tms99XX, 0x00, 0xFF, 0, p_result);
+    }
 
-  /**** loop in chunks of 256 to read vram ****/
-  for(index = 0; index < MEM_SIZE; index += amtRead)
+    if(pass) pass = marchVDPvram(p_tms99XX, 0xFF, 0x00, 1, p_result);
+
+    if(pass) pass = verifyVDPvramFast(p_tms99XX, 0x0000, 0x00, MEM_SIZE, p_result, VRAM_STAGE_MARCH);
+  }
+  else
   {
+    /**** March C-, solid then checkerboard background ****/
+    for(index = 0; pass && (index < 2); index++)
+    {
+      uint8_t background = (index ? 0x55 : 0x00);
+      uint8_t inverse = (uint8_t)~background;
+
+      fillVDPvramFast(p_tms99XX, 0x0000, background, MEM_SIZE);
+
+      pass = marchVDPvram(p_tms99XX, background, inverse, 0, p_result);
 
-    /**** read 256 chunk ****/
-    amtRead = (uint16_t)readVDPvram(p_tms99XX, buffer, sizeof(buffer), sizeof(buffer));
+      if(pass) pass = marchVDPvram(p_tms99XX, inverse, background, 0, p_result);
 
-    /**** check all chunks against original, return 0 if it fails ****/
-    for(bufIndex = 0; bufIndex < amtRead; bufIndex++)
+      if(pass) pass = marchVDPvram(p_tms99XX, background, inverse, 1, p_result);
+
+      if(pass) pass = marchVDPvram(p_tms99XX, inverse, background, 1, p_result);
+
+      if(pass) pass = verifyVDPvramFast(p_tms99XX, 0x0000, background, MEM_SIZE, p_result, VRAM_STAGE_MARCH);
+    }
+
+    /**** walking 1 then walking 0 on every data line ****/
+    for(index = 0; pass && (index < 16); index++)
     {
-      if(buffer[bufIndex] != data) return 0;
+      uint8_t walk = (uint8_t)(1 << (index & 0x07));
+
+      if(index > 7) walk = (uint8_t)~walk;
+
+      fillVDPvramFast(p_tms99XX, 0x0000, walk, MEM_SIZE);
+
+      pass = verifyVDPvramFast(p_tms99XX, 0x0000, walk, MEM_SIZE, p_result, VRAM_STAGE_WALK);
     }
   }
 
-  /**** return 1 on success ****/
-  return 1;
+  /**** restore blank state ****/
+  p_tms99XX->register1 = prevRegister1;
+
+  writeVDPregister(p_tms99XX, REGISTER_1, p_tms99XX->register1);
+
+  return pass;
+}
+
+#if STACK_CHECK
+/*** stack high water text ***/
+void setTMS99XXstackOverlay(struct s_tms99XX * const p_tms99XX, uint8_t x, uint8_t y)
+{
+  uint8_t  index = 0;
+  uint8_t  cols = 0;
+  uint16_t value = 0;
+  struct s_stackStats stats;
+  char text[TMS99XX_STACK_COLS] = "STK 00000/00000 OK ";
+
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+
+  cols = (p_tms99XX->vdpMode == TXT_MODE ? NAME_TABLE_TXT_COLS : NAME_TABLE_COLS);
+
+  if((uint16_t)x + TMS99XX_STACK_COLS > cols) return;
+
+  if(y >= NAME_TABLE_ROWS) return;
+
+  get_stack_stats(&stats);
+
+  /**** five digits each, filled from the right ****/
+  value = stats.peak;
+
+  for(index = 8; index > 3; index--)
+  {
+    text[index] += value % 10;
+
+    value /= 10;
+  }
+
+  value = stats.size;
+
+  for(index = 14; index > 9; index--)
+  {
+    text[index] += value % 10;
+
+    value /= 10;
+  }
+
+  if(stats.damaged)
+  {
+    text[16] = 'H';
+    text[17] = 'I';
+    text[18] = 'T';
+  }
+
+  setTMS99XXvramWriteAddr(p_tms99XX, p_tms99XX->nameTableAddr + (uint16_t)y * cols + x);
+
+  setTMS99XXvramData(p_tms99XX, text, sizeof(text));
 }
+#endif
 
 /** SEE MY PRIVATES **/
 /*** read VDP status register ***/
@@ -334,6 +737,17 @@ inline uint8_t readVDPstatus(struct s_tms99XX * const p_tms99XX)
   /**** read data ****/
   tempData = VDP_REG_PORT;
 
+  /**** frames the irq counted, it reads the flag itself so those are never counted twice ****/
+  if(p_tms99XX->bootTiming)
+  {
+    p_tms99XX->bootFrames += (uint8_t)(frameCount - p_tms99XX->bootCount);
+
+    p_tms99XX->bootCount = frameCount;
+
+    /**** irq off, reading status clears the frame flag, tally it ****/
+    if(tempData & (1 << FRAME_FLAG_BIT)) p_tms99XX->bootFrames++;
+  }
+
   return tempData;
   
 }
@@ -348,7 +762,7 @@ inline int readVDPvram(struct s_tms99XX * const p_tms99XX, uint8_t *p_data, int
 
   if(!p_data) return 0;
 
-  di();
+  vdp_lock();
 
   for(index = 0; index < size; index++)
   {
@@ -356,10 +770,12 @@ inline int readVDPvram(struct s_tms99XX * const p_tms99XX, uint8_t *p_data, int
     p_data[index % modLen] = VDP_DATA_PORT;
   }
 
+  vdp_move(index);
+
   /**** status read clears the interrupt, also screws up access if done before data transfer  ****/
   readVDPstatus(p_tms99XX);
 
-  ei();
+  vdp_unlock();
 
   return index;
 }
@@ -374,7 +790,7 @@ inline int writeVDPvram(struct s_tms99XX * const p_tms99XX, uint8_t const * cons
 
   if(!p_data) return 0;
 
-  di();
+  vdp_lock();
 
   for(index = 0; index < size; index++)
   {
@@ -382,10 +798,12 @@ inline int writeVDPvram(struct s_tms99XX * const p_tms99XX, uint8_t const * cons
     VDP_DATA_PORT = p_data[index % modLen];
   }
 
+  vdp_move(index);
+
   /**** status read clears the interrupt, also screws up access if done before data transfer ****/
   readVDPstatus(p_tms99XX);
 
-  ei();
+  vdp_unlock();
 
   return index;
 }
@@ -396,14 +814,14 @@ inline void writeVDPregister(struct s_tms99XX * const p_tms99XX, uint8_t regNum,
   /**** NULL Check ****/
   if(!p_tms99XX) return;
 
-  di();
+  vdp_lock();
 
   /**** write msb as 1 and reg num to lower 3 bits ****/
   VDP_REG_PORT = data;
 
   VDP_REG_PORT = (unsigned char)(0x80 | regNum);
 
-  ei();
+  vdp_unlock();
 }
 
 /*** set write or read VDP vram address ***/
@@ -412,7 +830,7 @@ inline void writeVDPvramAddr(struct s_tms99XX * const p_tms99XX, uint16_t addres
   /**** NULL Check ****/
   if(!p_tms99XX) return;
 
-  di();
+  vdp_lock();
 
   /**** output bottom 8 bits of 14 bit address ****/
   VDP_REG_PORT = (unsigned char)(0xFF & address);
@@ -420,7 +838,9 @@ inline void writeVDPvramAddr(struct s_tms99XX * const p_tms99XX, uint16_t addres
   /**** write bit 7 as 0, 6 as 1, and rest are top 6 bits of address ****/
   VDP_REG_PORT = (unsigned char)((rnw != 0 ? 0x00 : 0x40) | (unsigned char)(0x3F & (address >> 8)));
 
-  ei();
+  vdp_track(address, rnw);
+
+  vdp_unlock();
 }
 
 /*** set modes by setting vdpMode ***/
@@ -478,3 +898,744 @@ inline void initVDPmode(struct s_tms99XX * const p_tms99XX)
   /**** setup register 7 for backdrop color ****/
   writeVDPregister(p_tms99XX, REGISTER_7, p_tms99XX->colorReg);
 }
+
+/*** fill VDP vram at full bandwidth, display must be blanked ***/
+static void fillVDPvramFast(struct s_tms99XX * const p_tms99XX, uint16_t address, uint8_t data, uint16_t size)
+{
+  uint16_t chunk = 0;
+
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+
+  writeVDPvramAddr(p_tms99XX, address, 0);
+
+  fastData = data;
+
+  for(; size > 0; size -= chunk)
+  {
+    chunk = (size > FAST_CHUNK_SIZE ? FAST_CHUNK_SIZE : size);
+
+    fastRem = (uint8_t)(chunk & 0x07);
+
+    fastBlocks = (uint8_t)(chunk >> 3);
+
+    vdp_lock();
+
+    fastVDPfill();
+
+    vdp_move(chunk);
+
+    /**** poll status between chunks so no frame flag is missed ****/
+    readVDPstatus(p_tms99XX);
+
+    vdp_unlock();
+  }
+}
+
+/*** write fastRem bytes, then fastBlocks of 8 bytes of fastData. ~13 T-states a byte ***/
+static void fastVDPfill(void) __naked
+{
+  __asm
+    ld  c, #_VDP_DATA_PORT
+    ld  a, (_fastData)
+    ld  e, a
+    ld  a, (_fastRem)
+    or  a, a
+    jr  Z, 00111$
+    ld  b, a
+00110$:
+    out (c), e
+    djnz  00110$
+00111$:
+    ld  a, (_fastBlocks)
+    or  a, a
+    ret Z
+    ld  b, a
+00112$:
+    out (c), e
+    out (c), e
+    out (c), e
+    out (c), e
+    out (c), e
+    out (c), e
+    out (c), e
+    out (c), e
+    djnz  00112$
+    ret
+  __endasm;
+}
+
+/*** check VDP vram against a constant at full bandwidth, display must be blanked. size is a multiple of 8 ***/
+static uint8_t verifyVDPvramFast(struct s_tms99XX * const p_tms99XX, uint16_t address, uint8_t data, uint16_t size, struct s_tms99XX_vramTest *p_result, uint8_t stage)
+{
+  uint16_t chunk = 0;
+
+  /**** NULL Check ****/
+  if(!p_tms99XX) return 0;
+
+  writeVDPvramAddr(p_tms99XX, address, 1);
+
+  fastData = data;
+
+  for(; size > 0; size -= chunk)
+  {
+    chunk = (size > FAST_CHUNK_SIZE ? FAST_CHUNK_SIZE : size);
+
+    fastBlocks = (uint8_t)(chunk >> 3);
+
+    vdp_lock();
+
+    fastVDPverify();
+
+    vdp_move(chunk);
+
+    readVDPstatus(p_tms99XX);
+
+    vdp_unlock();
+
+    if(fastFail)
+    {
+      setVDPtestResult(p_result, address + fastCount, data, fastActual, stage);
+
+      return 0;
+    }
+
+    address += chunk;
+  }
+
+  return 1;
+}
+
+/*** read fastBlocks of 8 bytes and compare to fastData, first miss goes to fastCount/fastActual. ~29 T-states a byte ***/
+static void fastVDPverify(void) __naked
+{
+  __asm
+    ld  c, #_VDP_DATA_PORT
+    ld  a, (_fastData)
+    ld  e, a
+    ld  hl, #0
+    ld  a, (_fastBlocks)
+    or  a, a
+    jr  Z, 00122$
+    ld  b, a
+00120$:
+    in  a, (c)
+    cp  a, e
+    jr  NZ, 00121$
+    inc hl
+    in  a, (c)
+    cp  a, e
+    jr  NZ, 00121$
+    inc hl
+    in  a, (c)
+    cp  a, e
+    jr  NZ, 00121$
+    inc hl
+    in  a, (c)
+    cp  a, e
+    jr  NZ, 00121$
+    inc hl
+    in  a, (c)
+    cp  a, e
+    jr  NZ, 00121$
+    inc hl
+    in  a, (c)
+    cp  a, e
+    jr  NZ, 00121$
+    inc hl
+    in  a, (c)
+    cp  a, e
+    jr  NZ, 00121$
+    inc hl
+    in  a, (c)
+    cp  a, e
+    jr  NZ, 00121$
+    inc hl
+    djnz  00120$
+00122$:
+    xor a, a
+    ld  (_fastFail), a
+    ret
+00121$:
+    ld  (_fastActual), a
+    ld  (_fastCount), hl
+    ld  a, #1
+    ld  (_fastFail), a
+    ret
+  __endasm;
+}
+
+/*** one march element, read check then write each cell going up or down ***/
+static uint8_t marchVDPvram(struct s_tms99XX * const p_tms99XX, uint8_t readData, uint8_t writeData, uint8_t down, struct s_tms99XX_vramTest *p_result)
+{
+  uint16_t index = 0;
+
+  fastData = readData;
+
+  fastWrite = writeData;
+
+  fastDown = down;
+
+  for(index = 0; index < MEM_SIZE; index += MARCH_PAGE_SIZE)
+  {
+    /**** first cell of the page in march order ****/
+    fastCount = (down ? (uint16_t)(MEM_SIZE - 1 - index) : index);
+
+    vdp_lock();
+
+    fastVDPmarch();
+
+    readVDPstatus(p_tms99XX);
+
+    vdp_unlock();
+
+    if(fastFail)
+    {
+      setVDPtestResult(p_result, fastCount, readData, fastActual, VRAM_STAGE_MARCH);
+
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+/*** 256 cells from fastCount, each is read and checked against fastData then written with fastWrite before the next. The address is set for every access so the cell order is exact. Miss goes to fastCount/fastActual ***/
+static void fastVDPmarch(void) __naked
+{
+  __asm
+    ld  hl, (_fastCount)
+    ld  a, (_fastData)
+    ld  d, a
+    ld  a, (_fastWrite)
+    ld  e, a
+    ld  a, (_fastDown)
+    ld  c, a
+    ld  b, #0
+00150$:
+    ld  a, l
+    out (_VDP_REG_PORT), a
+    ld  a, h
+    out (_VDP_REG_PORT), a
+    nop
+    in  a, (_VDP_DATA_PORT)
+    cp  a, d
+    jr  NZ, 00153$
+    ld  a, l
+    out (_VDP_REG_PORT), a
+    ld  a, h
+    or  a, #0x40
+    out (_VDP_REG_PORT), a
+    ld  a, e
+    out (_VDP_DATA_PORT), a
+    bit 0, c
+    jr  NZ, 00151$
+    inc hl
+    djnz  00150$
+    jr  00152$
+00151$:
+    dec hl
+    djnz  00150$
+00152$:
+    xor a, a
+    ld  (_fastFail), a
+    ret
+00153$:
+    ld  (_fastActual), a
+    ld  (_fastCount), hl
+    ld  a, #1
+    ld  (_fastFail), a
+    ret
+  __endasm;
+}
+
+/*** address in address, each byte gets its low address xor high address. Any single address line fault aliases two different values. ***/
+static uint8_t addrVDPvram(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_vramTest *p_result)
+{
+  uint16_t page = 0;
+
+  writeVDPvramAddr(p_tms99XX, 0x0000, 0);
+
+  for(page = 0; page < (MEM_SIZE >> 8); page++)
+  {
+    fastData = (uint8_t)page;
+
+    vdp_lock();
+
+    fastVDPaddrWrite();
+
+    readVDPstatus(p_tms99XX);
+
+    vdp_unlock();
+  }
+
+  writeVDPvramAddr(p_tms99XX, 0x0000, 1);
+
+  for(page = 0; page < (MEM_SIZE >> 8); page++)
+  {
+    fastData = (uint8_t)page;
+
+    vdp_lock();
+
+    fastVDPaddrVerify();
+
+    readVDPstatus(p_tms99XX);
+
+    vdp_unlock();
+
+    if(fastFail)
+    {
+      setVDPtestResult(p_result, (page << 8) | fastCount, (uint8_t)(fastCount ^ page), fastActual, VRAM_STAGE_ADDRESS);
+
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+/*** write 256 bytes of offset xor fastData (page) ***/
+static void fastVDPaddrWrite(void) __naked
+{
+  __asm
+    ld  c, #_VDP_DATA_PORT
+    ld  a, (_fastData)
+    ld  d, a
+    ld  e, #0
+00130$:
+    ld  a, e
+    xor a, d
+    out (c), a
+    inc e
+    ld  a, e
+    xor a, d
+    out (c), a
+    inc e
+    jr  NZ, 00130$
+    ret
+  __endasm;
+}
+
+/*** read 256 bytes and check for offset xor fastData (page), first miss goes to fastCount/fastActual ***/
+static void fastVDPaddrVerify(void) __naked
+{
+  __asm
+    ld  c, #_VDP_DATA_PORT
+    ld  a, (_fastData)
+    ld  d, a
+    ld  e, #0
+00131$:
+    in  a, (c)
+    xor a, d
+    cp  a, e
+    jr  NZ, 00132$
+    inc e
+    jr  NZ, 00131$
+    xor a, a
+    ld  (_fastFail), a
+    ret
+00132$:
+    xor a, d
+    ld  (_fastActual), a
+    ld  l, e
+    ld  h, #0
+    ld  (_fastCount), hl
+    ld  a, #1
+    ld  (_fastFail), a
+    ret
+  __endasm;
+}
+
+/*** store a vram test failure ***/
+inline void setVDPtestResult(struct s_tms99XX_vramTest *p_result, uint16_t address, uint8_t expected, uint8_t actual, uint8_t stage)
+{
+  /**** NULL Check, result is optional ****/
+  if(!p_result) return;
+
+  p_result->address = address;
+
+  p_result->expected = expected;
+
+  p_result->actual = actual;
+
+  p_result->bits = (uint8_t)(expected ^ actual);
+
+  p_result->stage = stage;
+}
+
+/*** write VDP vram at full bandwidth, display must be blanked or in vblank ***/
+static void writeVDPvramFast(struct s_tms99XX * const p_tms99XX, uint16_t address, uint8_t const *p_data, uint16_t size)
+{
+  uint16_t chunk = 0;
+
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+
+  if(!p_data) return;
+
+  writeVDPvramAddr(p_tms99XX, address, 0);
+
+  for(; size > 0; size -= chunk)
+  {
+    chunk = (size > FAST_CHUNK_SIZE ? FAST_CHUNK_SIZE : size);
+
+    p_fastData = (uint8_t *)p_data;
+
+    fastRem = (uint8_t)(chunk & 0x07);
+
+    fastBlocks = (uint8_t)(chunk >> 3);
+
+    vdp_lock();
+
+    fastVDPwrite();
+
+    vdp_move(chunk);
+
+    readVDPstatus(p_tms99XX);
+
+    vdp_unlock();
+
+    p_data += chunk;
+  }
+}
+
+/*** write fastRem bytes, then fastBlocks of 8 bytes from p_fastData. ~16 T-states a byte ***/
+static void fastVDPwrite(void) __naked
+{
+  __asm
+    ld  hl, (_p_fastData)
+    ld  c, #_VDP_DATA_PORT
+    ld  a, (_fastRem)
+    or  a, a
+    jr  Z, 00141$
+    ld  b, a
+00140$:
+    outi
+    jr  NZ, 00140$
+00141$:
+    ld  a, (_fastBlocks)
+    or  a, a
+    ret Z
+    ld  d, a
+00142$:
+    outi
+    outi
+    outi
+    outi
+    outi
+    outi
+    outi
+    outi
+    dec d
+    jr  NZ, 00142$
+    ret
+  __endasm;
+}
+
+/*** fastBlocks glyphs from p_fastData, fastData is the style and fastRem the padding rows. Each row is styled in registers then written, p_fastData is left at the next glyph. ~110 T-states a byte, slow enough for the display on ***/
+static void fastVDPfont(void) __naked
+{
+  __asm
+    ld  hl, (_p_fastData)
+    ld  a, (_fastData)
+    ld  e, a
+00160$:
+    ld  d, #0
+    ld  b, #8
+00161$:
+    ld  a, (_fastRem)
+    cp  a, b
+    ld  a, #0
+    jr  NC, 00162$
+    ld  a, (hl)
+    inc hl
+00162$:
+    bit 1, e
+    jr  Z, 00163$
+    ld  c, a
+    srl a
+    or  a, c
+00163$:
+    bit 2, e
+    jr  Z, 00164$
+    ld  c, a
+    ld  a, d
+    srl a
+    or  a, c
+    ld  d, c
+00164$:
+    bit 3, e
+    jr  Z, 00165$
+    ld  c, a
+    ld  a, b
+    dec a
+    ld  a, c
+    jr  NZ, 00165$
+    ld  a, #0xFF
+00165$:
+    bit 0, e
+    jr  Z, 00166$
+    cpl
+00166$:
+    out (_VDP_DATA_PORT), a
+    djnz  00161$
+    ld  a, (_fastBlocks)
+    dec a
+    ld  (_fastBlocks), a
+    jr  NZ, 00160$
+    ld  (_p_fastData), hl
+    ret
+  __endasm;
+}
+
+/*** read VDP vram at full bandwidth, display must be blanked or in vblank ***/
+static void readVDPvramFast(struct s_tms99XX * const p_tms99XX, uint16_t address, uint8_t *p_data, uint16_t size)
+{
+  uint16_t chunk = 0;
+
+  /**** NULL Check ****/
+  if(!p_tms99XX) return;
+
+  if(!p_data) return;
+
+  writeVDPvramAddr(p_tms99XX, address, 1);
+
+  for(; size > 0; size -= chunk)
+  {
+    chunk = (size > FAST_CHUNK_SIZE ? FAST_CHUNK_SIZE : size);
+
+    p_fastData = p_data;
+
+    fastRem = (uint8_t)(chunk & 0x07);
+
+    fastBlocks = (uint8_t)(chunk >> 3);
+
+    vdp_lock();
+
+    fastVDPread();
+
+    vdp_move(chunk);
+
+    readVDPstatus(p_tms99XX);
+
+    vdp_unlock();
+
+    p_data += chunk;
+  }
+}
+
+/*** read fastRem bytes, then fastBlocks of 8 bytes to p_fastData. ~16 T-states a byte ***/
+static void fastVDPread(void) __naked
+{
+  __asm
+    ld  hl, (_p_fastData)
+    ld  c, #_VDP_DATA_PORT
+    ld  a, (_fastRem)
+    or  a, a
+    jr  Z, 00151$
+    ld  b, a
+00150$:
+    ini
+    jr  NZ, 00150$
+00151$:
+    ld  a, (_fastBlocks)
+    or  a, a
+    ret Z
+    ld  d, a
+00152$:
+    ini
+    ini
+    ini
+    ini
+    ini
+    ini
+    ini
+    ini
+    dec d
+    jr  NZ, 00152$
+    ret
+  __endasm;
+}
+
+/*** start and size of each table the current mode uses, returns number of tables ***/
+static uint8_t getVDPtables(struct s_tms99XX * const p_tms99XX, uint16_t *p_start, uint16_t *p_size)
+{
+  uint8_t number = 0;
+
+  p_start[number] = p_tms99XX->nameTableAddr;
+  p_size[number++] = (p_tms99XX->vdpMode == TXT_MODE ? NAME_TABLE_TXT_SIZE : NAME_TABLE_SIZE);
+
+  p_start[number] = p_tms99XX->patternTableAddr;
+
+  switch(p_tms99XX->vdpMode)
+  {
+    case TXT_MODE:
+      p_size[number++] = PATTERN_TABLE_SIZE;
+      /**** no color or sprite tables ****/
+      return number;
+    case GFXII_MODE:
+      p_size[number++] = PATTERN_TABLE_GFXII_SIZE;
+      p_start[number] = p_tms99XX->colorTableAddr;
+      p_size[number++] = COLOR_TABLE_GFXII_SIZE;
+      break;
+    case BMP_MODE:
+      p_size[number++] = PATTERN_TABLE_BMP_SIZE;
+      break;
+    default:
+      p_size[number++] = PATTERN_TABLE_SIZE;
+      p_start[number] = p_tms99XX->colorTableAddr;
+      p_size[number++] = COLOR_TABLE_SIZE;
+      break;
+  }
+
+  p_start[number] = p_tms99XX->spriteAttributeAddr;
+  p_size[number++] = SPRITE_ATTRIBUTE_TABLE_SIZE;
+
+  p_start[number] = p_tms99XX->spritePatternAddr;
+  p_size[number++] = PATTERN_TABLE_SIZE;
+
+  return number;
+}
+
+/*** move a snapshot. Names first, after that the screen names match the store either way, so GFX II reads each row back once from the screen to find the cell patterns and colors. ***/
+static void moveVDPsnapshot(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_snapshot * const p_snap, uint8_t restore)
+{
+  uint8_t  row = 0;
+  uint8_t  col = 0;
+  uint8_t  run = 0;
+  uint8_t  cols = (p_tms99XX->vdpMode == TXT_MODE ? NAME_TABLE_TXT_COLS : NAME_TABLE_COLS);
+  uint16_t cells = (uint16_t)p_snap->width * p_snap->height;
+  uint16_t rowAddr = 0;
+  uint16_t bankAddr = 0;
+  uint16_t patIndex = 0;
+  uint16_t colorIndex = 0;
+  uint8_t  names[NAME_TABLE_COLS];
+
+  p_snap->index = 0;
+
+  rowAddr = p_tms99XX->nameTableAddr + ((uint16_t)p_snap->y * cols) + p_snap->x;
+
+  /**** full width rows are one run of names ****/
+  if(p_snap->width == cols)
+  {
+    moveVDPsegment(p_tms99XX, p_snap, rowAddr, cells, restore);
+  }
+  else
+  {
+    for(row = 0; row < p_snap->height; row++)
+    {
+      moveVDPsegment(p_tms99XX, p_snap, rowAddr, p_snap->width, restore);
+
+      rowAddr += cols;
+    }
+  }
+
+  if(p_tms99XX->vdpMode != GFXII_MODE) return;
+
+  /**** store holds all patterns then all colors ****/
+  patIndex = cells;
+
+  colorIndex = cells + (cells << 3);
+
+  rowAddr = p_tms99XX->nameTableAddr + ((uint16_t)p_snap->y * cols) + p_snap->x;
+
+  for(row = p_snap->y; row < p_snap->y + p_snap->height; row++)
+  {
+    readVDPvramFast(p_tms99XX, rowAddr, names, p_snap->width);
+
+    /**** each third of the screen has its own 2K bank ****/
+    bankAddr = (uint16_t)(row >> 3) << 11;
+
+    for(col = 0; col < p_snap->width; col += run)
+    {
+      /**** consecutive names have consecutive patterns and colors, one segment each, no wrap past 255 ****/
+      for(run = 1; (col + run < p_snap->width) && (names[col + run] == names[col] + run); run++);
+
+      p_snap->index = patIndex;
+
+      moveVDPsegment(p_tms99XX, p_snap, p_tms99XX->patternTableAddr + bankAddr + ((uint16_t)names[col] << 3), (uint16_t)run << 3, restore);
+
+      p_snap->index = colorIndex;
+
+      moveVDPsegment(p_tms99XX, p_snap, p_tms99XX->colorTableAddr + bankAddr + ((uint16_t)names[col] << 3), (uint16_t)run << 3, restore);
+
+      patIndex += (uint16_t)run << 3;
+
+      colorIndex += (uint16_t)run << 3;
+    }
+
+    rowAddr += cols;
+  }
+}
+
+/*** move a snapshot, blanked when it is too big for a vblank ***/
+static void moveVDPsnapshotSafe(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_snapshot * const p_snap, uint8_t restore)
+{
+  uint8_t  prevRegister1 = p_tms99XX->register1;
+  uint16_t segments = p_snap->height;
+  uint32_t cost = 0;
+
+  /**** worst case, no GFX II cells merge ****/
+  if(p_tms99XX->vdpMode == GFXII_MODE) segments += (uint16_t)p_snap->width * p_snap->height * 2;
+
+  cost = (uint32_t)p_snap->size * SNAPSHOT_BYTE_T + (uint32_t)segments * SNAPSHOT_SEGMENT_T;
+
+  /**** spare vram store reads and writes every byte ****/
+  if(!p_snap->p_buffer) cost <<= 1;
+
+  if(cost <= SNAPSHOT_VBLANK_T)
+  {
+    moveVDPsnapshot(p_tms99XX, p_snap, restore);
+
+    return;
+  }
+
+  setTMS99XXblank(p_tms99XX, 1);
+
+  moveVDPsnapshot(p_tms99XX, p_snap, restore);
+
+  /**** restore blank state ****/
+  p_tms99XX->register1 = prevRegister1;
+
+  writeVDPregister(p_tms99XX, REGISTER_1, p_tms99XX->register1);
+}
+
+/*** move one block of vram to or from the snapshot store ***/
+static void moveVDPsegment(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_snapshot * const p_snap, uint16_t address, uint16_t size, uint8_t restore)
+{
+  uint8_t  chunk = 0;
+  uint8_t  temp[32];
+  uint16_t storeAddr = 0;
+
+  if(p_snap->p_buffer)
+  {
+    if(restore)
+    {
+      writeVDPvramFast(p_tms99XX, address, p_snap->p_buffer + p_snap->index, size);
+    }
+    else
+    {
+      readVDPvramFast(p_tms99XX, address, p_snap->p_buffer + p_snap->index, size);
+    }
+
+    p_snap->index += size;
+
+    return;
+  }
+
+  /**** spare vram store, vdp has no copy so bounce 32 bytes at a time through RAM ****/
+  for(; size > 0; size -= chunk)
+  {
+    chunk = (uint8_t)(size > sizeof(temp) ? sizeof(temp) : size);
+
+    storeAddr = p_snap->vramAddr + p_snap->index;
+
+    readVDPvramFast(p_tms99XX, (restore ? storeAddr : address), temp, chunk);
+
+    writeVDPvramFast(p_tms99XX, (restore ? address : storeAddr), temp, chunk);
+
+    p_snap->index += chunk;
+
+    address += chunk;
+  }
+}
@@ -0,0 +1,371 @@
+/*******************************************************************************
+ * @file    tms99XXfx.c
+ * @brief   Color effects for TI TMS9918/28/29 video display processor library.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Fades, color cycling, and flashes queued once a frame.
+ *
+ * @license mit
+ *
+ * Copyright 2026 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <base.h>
+#include <stdint.h>
+
+#include <tms99XX.h>
+#include <tms99XXfx.h>
+
+/** FADE RAMPS **/
+/*** each TMS color stepped down by brightness and hue to black, transparent stays transparent ***/
+const uint8_t c_tms99XX_fadeRamp[16 * FX_FADE_STEPS] =
+{
+  TMS_TRANSPARENT,  TMS_TRANSPARENT,  TMS_TRANSPARENT,  TMS_TRANSPARENT,
+  TMS_BLACK,        TMS_BLACK,        TMS_BLACK,        TMS_BLACK,
+  TMS_MEDIUM_GREEN, TMS_DARK_GREEN,   TMS_DARK_GREEN,   TMS_BLACK,
+  TMS_LIGHT_GREEN,  TMS_MEDIUM_GREEN, TMS_DARK_GREEN,   TMS_BLACK,
+  TMS_DARK_BLUE,    TMS_DARK_BLUE,    TMS_BLACK,        TMS_BLACK,
+  TMS_LIGHT_BLUE,   TMS_DARK_BLUE,    TMS_DARK_BLUE,    TMS_BLACK,
+  TMS_DARK_RED,     TMS_DARK_RED,     TMS_BLACK,        TMS_BLACK,
+  TMS_CYAN,         TMS_LIGHT_BLUE,   TMS_DARK_BLUE,    TMS_BLACK,
+  TMS_MEDIUM_RED,   TMS_DARK_RED,     TMS_DARK_RED,     TMS_BLACK,
+  TMS_LIGHT_RED,    TMS_MEDIUM_RED,   TMS_DARK_RED,     TMS_BLACK,
+  TMS_DARK_YELLOW,  TMS_DARK_RED,     TMS_DARK_RED,     TMS_BLACK,
+  TMS_LIGHT_YELLOW, TMS_DARK_YELLOW,  TMS_DARK_RED,     TMS_BLACK,
+  TMS_DARK_GREEN,   TMS_DARK_GREEN,   TMS_BLACK,        TMS_BLACK,
+  TMS_MAGENTA,      TMS_DARK_BLUE,    TMS_DARK_BLUE,    TMS_BLACK,
+  TMS_GREY,         TMS_GREY,         TMS_DARK_BLUE,    TMS_BLACK,
+  TMS_WHITE,        TMS_GREY,         TMS_DARK_BLUE,    TMS_BLACK
+};
+
+/** SEE MY PRIVATES **/
+/*** mark entry for write ***/
+inline void setFXdirty(struct s_tms99XXfx * const p_fx, uint8_t entry);
+/*** mark all entries for write ***/
+inline void setFXdirtyAll(struct s_tms99XXfx * const p_fx);
+/*** color to write for an entry with fade and flash applied ***/
+inline uint8_t getFXcolor(struct s_tms99XXfx * const p_fx, uint8_t entry);
+/*** take the backdrop base from the driver, main code may have set it ***/
+inline void getFXbackdrop(struct s_tms99XXfx * const p_fx);
+
+/** INITIALIZE AND FREE MY STRUCTS **/
+
+/*** Initialize color effects ***/
+void initTMS99XXfx(struct s_tms99XXfx * const p_fx, struct s_tms99XX * const p_tms99XX, uint8_t const * const p_colorTable)
+{
+  uint8_t index = 0;
+
+  /**** NULL Check ****/
+  if(!p_fx) return;
+
+  if(!p_tms99XX) return;
+
+  p_fx->p_tms99XX = p_tms99XX;
+
+  for(index = 0; index < COLOR_TABLE_SIZE; index++)
+  {
+    p_fx->base[index] = (p_colorTable ? p_colorTable[index] : 0);
+  }
+
+  p_fx->base[FX_BACKDROP] = p_tms99XX->colorReg;
+
+  for(index = 0; index < sizeof(p_fx->dirty); index++)
+  {
+    p_fx->dirty[index] = 0;
+  }
+
+  p_fx->scan = 0;
+
+  p_fx->fadeDir = FX_FADE_NONE;
+  p_fx->fadeStep = 0;
+  p_fx->fadeRate = 0;
+  p_fx->fadeCount = 0;
+
+  p_fx->cycleStart = 0;
+  p_fx->cycleLen = 0;
+  p_fx->cycleRate = 0;
+  p_fx->cycleCount = 0;
+
+  p_fx->flashEntry = 0;
+  p_fx->flashColor = 0;
+  p_fx->flashRate = 0;
+  p_fx->flashCount = 0;
+  p_fx->flashTimer = 0;
+  p_fx->flashState = 0;
+}
+
+/** SET YOUR DATA **/
+
+/*** set an entry color ***/
+void setTMS99XXfxColor(struct s_tms99XXfx * const p_fx, uint8_t entry, uint8_t color)
+{
+  /**** NULL Check ****/
+  if(!p_fx) return;
+
+  if(entry >= FX_ENTRIES) return;
+
+  p_fx->base[entry] = color;
+
+  /**** the driver copy is the unfaded backdrop ****/
+  if(entry == FX_BACKDROP) p_fx->p_tms99XX->colorReg = color;
+
+  setFXdirty(p_fx, entry);
+}
+
+/*** start a fade ***/
+void setTMS99XXfxFade(struct s_tms99XXfx * const p_fx, uint8_t direction, uint8_t rate)
+{
+  /**** NULL Check ****/
+  if(!p_fx) return;
+
+  getFXbackdrop(p_fx);
+
+  p_fx->fadeDir = direction;
+
+  p_fx->fadeRate = rate;
+
+  p_fx->fadeCount = 0;
+
+  /**** fades always run the full ramp ****/
+  p_fx->fadeStep = (direction == FX_FADE_IN ? FX_FADE_STEPS - 1 : 0);
+
+  setFXdirtyAll(p_fx);
+}
+
+/*** start or stop color cycling ***/
+void setTMS99XXfxCycle(struct s_tms99XXfx * const p_fx, uint8_t start, uint8_t len, uint8_t rate)
+{
+  /**** NULL Check ****/
+  if(!p_fx) return;
+
+  if((uint16_t)start + len > FX_ENTRIES) return;
+
+  getFXbackdrop(p_fx);
+
+  p_fx->cycleStart = start;
+
+  p_fx->cycleLen = len;
+
+  p_fx->cycleRate = (len > 1 ? rate : 0);
+
+  p_fx->cycleCount = 0;
+}
+
+/*** start or stop a flash ***/
+void setTMS99XXfxFlash(struct s_tms99XXfx * const p_fx, uint8_t entry, uint8_t color, uint8_t rate, uint8_t count)
+{
+  /**** NULL Check ****/
+  if(!p_fx) return;
+
+  if(entry >= FX_ENTRIES) return;
+
+  /**** put the old entry back if a flash was showing ****/
+  if(p_fx->flashState) setFXdirty(p_fx, p_fx->flashEntry);
+
+  getFXbackdrop(p_fx);
+
+  p_fx->flashEntry = entry;
+
+  p_fx->flashColor = color;
+
+  p_fx->flashRate = rate;
+
+  p_fx->flashCount = count;
+
+  p_fx->flashTimer = 0;
+
+  p_fx->flashState = 0;
+}
+
+/** GET YOUR DATA **/
+
+/*** check for running effects ***/
+uint8_t getTMS99XXfxBusy(struct s_tms99XXfx * const p_fx)
+{
+  uint8_t index = 0;
+
+  /**** NULL Check ****/
+  if(!p_fx) return 0;
+
+  if(p_fx->fadeDir || p_fx->cycleRate || p_fx->flashCount) return 1;
+
+  for(index = 0; index < sizeof(p_fx->dirty); index++)
+  {
+    if(p_fx->dirty[index]) return 1;
+  }
+
+  return 0;
+}
+
+/** RUN ONCE A FRAME **/
+
+/*** step effects and write queued entries ***/
+void tickTMS99XXfx(struct s_tms99XXfx * const p_fx)
+{
+  uint8_t index = 0;
+  uint8_t entry = 0;
+  uint8_t writes = 0;
+  uint8_t nextEntry = FX_ENTRIES;
+  uint8_t temp = 0;
+
+  /**** NULL Check ****/
+  if(!p_fx) return;
+
+  /**** fade, every step changes all entries ****/
+  if(p_fx->fadeDir && (++p_fx->fadeCount >= p_fx->fadeRate))
+  {
+    p_fx->fadeCount = 0;
+
+    if(p_fx->fadeDir == FX_FADE_OUT)
+    {
+      if(p_fx->fadeStep < FX_FADE_STEPS - 1) p_fx->fadeStep++;
+
+      if(p_fx->fadeStep == FX_FADE_STEPS - 1) p_fx->fadeDir = FX_FADE_NONE;
+    }
+    else
+    {
+      if(p_fx->fadeStep > 0) p_fx->fadeStep--;
+
+      if(p_fx->fadeStep == 0) p_fx->fadeDir = FX_FADE_NONE;
+    }
+
+    setFXdirtyAll(p_fx);
+  }
+
+  /**** cycle, rotate the range by one with the last entry moving to the first ****/
+  if(p_fx->cycleRate && (++p_fx->cycleCount >= p_fx->cycleRate))
+  {
+    p_fx->cycleCount = 0;
+
+    entry = (uint8_t)(p_fx->cycleStart + p_fx->cycleLen - 1);
+
+    temp = p_fx->base[entry];
+
+    for(; entry > p_fx->cycleStart; entry--)
+    {
+      p_fx->base[entry] = p_fx->base[entry - 1];
+
+      setFXdirty(p_fx, entry);
+    }
+
+    p_fx->base[entry] = temp;
+
+    setFXdirty(p_fx, entry);
+  }
+
+  /**** flash, a flash is one on and one off toggle ****/
+  if(p_fx->flashCount && (++p_fx->flashTimer >= p_fx->flashRate))
+  {
+    p_fx->flashTimer = 0;
+
+    p_fx->flashState ^= 1;
+
+    if(!p_fx->flashState) p_fx->flashCount--;
+
+    setFXdirty(p_fx, p_fx->flashEntry);
+  }
+
+  /**** write up to FX_MAX_WRITES dirty entries, starting where the last tick stopped ****/
+  for(index = 0; (index < FX_ENTRIES) && (writes < FX_MAX_WRITES); index++)
+  {
+    entry = p_fx->scan;
+
+    p_fx->scan = (entry + 1 >= FX_ENTRIES ? 0 : entry + 1);
+
+    temp = (uint8_t)(1 << (entry & 0x07));
+
+    if(!(p_fx->dirty[entry >> 3] & temp)) continue;
+
+    p_fx->dirty[entry >> 3] &= (uint8_t)~temp;
+
+    if(entry == FX_BACKDROP)
+    {
+      /**** colorReg keeps the unfaded color, only the register sees the effect ****/
+      setTMS99XXreg(p_fx->p_tms99XX, REGISTER_7, getFXcolor(p_fx, entry));
+
+      writes++;
+
+      continue;
+    }
+
+    /**** only graphics I has a 32 byte color table ****/
+    if(p_fx->p_tms99XX->vdpMode != GFXI_MODE) continue;
+
+    /**** sequential entries keep the auto incremented address ****/
+    if(entry != nextEntry) setTMS99XXvramWriteAddr(p_fx->p_tms99XX, p_fx->p_tms99XX->colorTableAddr + entry);
+
+    vdp_lock();
+
+    VDP_DATA_PORT = getFXcolor(p_fx, entry);
+
+    vdp_move(1);
+
+    vdp_unlock();
+
+    nextEntry = entry + 1;
+
+    writes++;
+  }
+}
+
+/** SEE MY PRIVATES **/
+/*** mark entry for write ***/
+inline void setFXdirty(struct s_tms99XXfx * const p_fx, uint8_t entry)
+{
+  p_fx->dirty[entry >> 3] |= (uint8_t)(1 << (entry & 0x07));
+}
+
+/*** mark all entries for write ***/
+inline void setFXdirtyAll(struct s_tms99XXfx * const p_fx)
+{
+  uint8_t index = 0;
+
+  for(index = 0; index < FX_ENTRIES; index++)
+  {
+    setFXdirty(p_fx, index);
+  }
+}
+
+/*** color to write for an entry with fade and flash applied ***/
+inline uint8_t getFXcolor(struct s_tms99XXfx * const p_fx, uint8_t entry)
+{
+  uint8_t color = p_fx->base[entry];
+
+  if(p_fx->flashState && (entry == p_fx->flashEntry)) color = p_fx->flashColor;
+
+  if(!p_fx->fadeStep) return color;
+
+  /**** both nibbles go through the same ramp step ****/
+  return (uint8_t)((c_tms99XX_fadeRamp[((color >> 4) * FX_FADE_STEPS) + p_fx->fadeStep] << 4) | c_tms99XX_fadeRamp[((color & 0x0F) * FX_FADE_STEPS) + p_fx->fadeStep]);
+}
+
+/*** take the backdrop base from the driver, main code may have set it ***/
+inline void getFXbackdrop(struct s_tms99XXfx * const p_fx)
+{
+  /**** a cycle running over the backdrop owns the base ****/
+  if(p_fx->cycleRate && (FX_BACKDROP >= p_fx->cycleStart) && (FX_BACKDROP < p_fx->cycleStart + p_fx->cycleLen)) return;
+
+  if(p_fx->base[FX_BACKDROP] == p_fx->p_tms99XX->colorReg) return;
+
+  p_fx->base[FX_BACKDROP] = p_fx->p_tms99XX->colorReg;
+
+  setFXdirty(p_fx, FX_BACKDROP);
+}
@@ -3,7 +3,9 @@
  * @brief   Library for TI TMS9918/28/29 video display processor.
  * @author  Jay Convertino(electrobs@gmail.com)
  * @date    2022.02.12
- * @details 16K is assumed for memory.
+ * @details 16K is assumed for memory. Port sequences are wrapped in the arch
+ *          vdp_lock and vdp_unlock, on coleco an NMI inside one waits for the
+ *          unlock and the vram address is put back after the vdp callback.
  * 
  * @version 0.0.1
  * 
@@ -58,6 +60,17 @@
  ******************************************************************************/
 void initTMS99XX(struct s_tms99XX * const p_tms99XX, uint8_t vdpMode, uint8_t backColor);
 
+/***************************************************************************//**
+ * @brief   Initialize only the VRAM tables the current vdpMode uses. Name,
+ *          pattern, and color tables are cleared, sprite attributes are cleared
+ *          with sprite 0 set to the terminator. The display is blanked while
+ *          this runs so data is written at full bandwidth, the previous blank
+ *          state is restored after.
+ * 
+ * @param   p_tms99XX pointer to struct to contain data.
+ ******************************************************************************/
+void initTMS99XXvram(struct s_tms99XX * const p_tms99XX);
+
 /***************************************************************************//**
  * @brief   Set the TMS99XX mode to one of 4. Text, Graphics I, Graphics II,
  *          and bitmap. This will also reset all addresses for the needed mode.
@@ -139,6 +152,23 @@ void setTMS99XXreg(struct s_tms99XX * const p_tms99XX, uint8_t regNum, uint8_t r
  ******************************************************************************/
 int setTMS99XXvramTableData(struct s_tms99XX * const p_tms99XX, uint16_t tableAddr, void const * const p_data, int startNum, int number, int size);
 
+/***************************************************************************//**
+ * @brief   Upload a range of glyphs into the pattern table with a style 
+ *          applied on the way, so styled copies of a font need no extra ROM.
+ *          Glyphs stored with less than 8 rows are padded out. Plain 8 row
+ *          glyphs use the unrolled port loop, call with the display blanked or
+ *          during vblank. Styles are applied in the out loop itself.
+ * 
+ * @param   p_tms99XX pointer to struct to contain data.
+ * @param   p_font font description, exe &c_tms99XX_asciiFont.
+ * @param   first first character to upload, clipped to the font.
+ * @param   number quantity of characters to upload, clipped to the font.
+ * @param   slot pattern table entry the first character is written to.
+ * @param   style FONT_PLAIN, or FONT_INVERT, FONT_BOLD, FONT_SHADOW, 
+ *          FONT_UNDERLINE or'd together.
+ ******************************************************************************/
+void setTMS99XXfont(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_font const * const p_font, uint8_t first, uint16_t number, uint8_t slot, uint8_t style);
+
 /***************************************************************************//**
  * @brief   Set the start of the VRAM address to write to. After this
  *          is set writes will auto increment the address.
@@ -204,20 +234,121 @@ int getTMS99XXvramData(struct s_tms99XX * const p_tms99XX, void *p_data, int siz
  ******************************************************************************/
 uint8_t getTMS99XXstatus(struct s_tms99XX * const p_tms99XX);
 
+/***************************************************************************//**
+ * @brief   Number of frames counted from initTMS99XX till the first time the
+ *          screen is unblanked. Frames are taken from frameCount, so turn the
+ *          VDP irq on after init, each driver status read folds them in and
+ *          keeps the 8 bit count from wrapping. With the irq off only frames
+ *          a driver status read catches in the frame flag count.
+ * 
+ * @param   p_tms99XX pointer to struct to contain data.
+ * @return  Frames from init to first displayed frame.
+ ******************************************************************************/
+uint16_t getTMS99XXbootFrames(struct s_tms99XX * const p_tms99XX);
+
+/***************************************************************************//**
+ * @brief   Find the largest block of VRAM not used by the tables of the current
+ *          vdpMode.
+ * 
+ * @param   p_tms99XX pointer to struct to contain data.
+ * @param   p_addr pointer to store the start address of the free block.
+ * @return  size of the free block in bytes, 0 if none.
+ ******************************************************************************/
+uint16_t getTMS99XXfreeVram(struct s_tms99XX * const p_tms99XX, uint16_t *p_addr);
+
+/***************************************************************************//**
+ * @brief   Bytes needed to snapshot a name table region in the current mode.
+ *          One byte per cell, GFX II adds 8 pattern and 8 color bytes per cell.
+ * 
+ * @param   p_tms99XX pointer to struct to contain data.
+ * @param   width columns in the region.
+ * @param   height rows in the region.
+ * @return  bytes needed.
+ ******************************************************************************/
+uint16_t getTMS99XXsnapshotSize(struct s_tms99XX * const p_tms99XX, uint8_t width, uint8_t height);
+
+/***************************************************************************//**
+ * @brief   Save a rectangular name table region, and in GFX II the patterns and
+ *          colors its cells use, so an overlay can be drawn over it. Data moves
+ *          with unrolled port loops at 16 T-states a byte, faster than the VDP
+ *          takes it with the display on. A move that fits SNAPSHOT_VBLANK_T,
+ *          about SNAPSHOT_VBLANK_BYTES in one segment, call at the start of
+ *          vblank (vdp irq callback). GFX II cells with consecutive names
+ *          move their patterns and colors as one segment. Anything larger
+ *          blanks the display for the move.
+ * 
+ * @param   p_tms99XX pointer to struct to contain data.
+ * @param   p_snap pointer to snapshot struct to fill.
+ * @param   x first column.
+ * @param   y first row.
+ * @param   width columns in the region.
+ * @param   height rows in the region.
+ * @param   p_buffer RAM store of at least getTMS99XXsnapshotSize bytes, 0 to 
+ *          use the free VRAM found by getTMS99XXfreeVram.
+ * @param   size size of p_buffer in bytes.
+ * @return  0 for error (region off screen or store too small), 1 for saved.
+ ******************************************************************************/
+uint8_t getTMS99XXsnapshot(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_snapshot * const p_snap, uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t *p_buffer, uint16_t size);
+
+/***************************************************************************//**
+ * @brief   Restore a region saved by getTMS99XXsnapshot in one burst. The
+ *          same SNAPSHOT_VBLANK_T limit as getTMS99XXsnapshot applies,
+ *          larger restores blank the display for the move.
+ * 
+ * @param   p_tms99XX pointer to struct to contain data.
+ * @param   p_snap pointer to snapshot struct filled by getTMS99XXsnapshot.
+ ******************************************************************************/
+void setTMS99XXsnapshot(struct s_tms99XX * const p_tms99XX, struct s_tms99XX_snapshot * const p_snap);
+
 /***************************************************************************//**
  * @brief   Clear all data from VRAM from 0x0000 to 0x3FFF. This will block 
- *          till it has cleared all data.
+ *          till it has cleared all data. Display is blanked during the clear.
  * 
  * @param   p_tms99XX pointer to struct to contain data.
  ******************************************************************************/
 void clearTMS99XXvramData(struct s_tms99XX * const p_tms99XX);
 
 /***************************************************************************//**
- * @brief   Test all VRAM. This will block till all data written.
+ * @brief   Test all VRAM. This will block till all data written. Same as 
+ *          testTMS99XXvram with VRAM_TEST_QUICK and no result.
  * 
  * @param   p_tms99XX pointer to struct to contain data.
  * @return  0 for error, 1 for pass.
  ******************************************************************************/
 uint8_t checkTMS99XXvram(struct s_tms99XX * const p_tms99XX);
 
+/***************************************************************************//**
+ * @brief   Test all VRAM with an address in address test and march tests. The
+ *          display is blanked and data is checked as it streams from the port,
+ *          no RAM buffer is used. March elements read then write one cell at
+ *          a time in address order, the full test takes a few seconds. VRAM contents are destroyed, the previous
+ *          blank state is restored after. Stops at the first failure.
+ * 
+ * @param   p_tms99XX pointer to struct to contain data.
+ * @param   coverage VRAM_TEST_QUICK or VRAM_TEST_FULL.
+ * @param   p_result pointer to store the failing address and bits, can be 0.
+ * @return  0 for error, 1 for pass.
+ ******************************************************************************/
+uint8_t testTMS99XXvram(struct s_tms99XX * const p_tms99XX, uint8_t coverage, struct s_tms99XX_vramTest *p_result);
+
+#if STACK_CHECK
+/**
+ * @def TMS99XX_STACK_COLS
+ * cells the stack overlay writes, "STK ppppp/sssss OK ".
+ */
+#define TMS99XX_STACK_COLS 19
+
+/***************************************************************************//**
+ * @brief   Write the stack high water mark from get_stack_stats as text into
+ *          the name table, peak and region size in bytes then OK or HIT for
+ *          guard damage. Needs the ascii font loaded at its character codes.
+ *          Only built with STACK_CHECK.
+ * 
+ * @param   p_tms99XX pointer to struct to contain data.
+ * @param   x first column.
+ * @param   y row.
+ ******************************************************************************/
+void setTMS99XXstackOverlay(struct s_tms99XX * const p_tms99XX, uint8_t x, uint8_t y);
+#endif
+
 #endif
@@ -4,6 +4,16 @@
  * @author  Jay Convertino(electrobs@gmail.com)
  * @date    2022.04.24
  * 
+ * @details Printable characters 32 to 127 only. Define TMS99XX_ASCII_7ROW to
+ *          store 7 rows per glyph (row 7 is blank in all but _, which is 
+ *          merged up a row) and have setTMS99XXfont pad the 8th on upload.
+ *          On Coleco define TMS99XX_ASCII_BIOS to use the character set in
+ *          the BIOS ROM and leave the table out of the cart entirely. The
+ *          BIOS set is upper case only, TMS99XX_ASCII_LOWER is 0 then and
+ *          lower case shows garbage unless 'A' to 'Z' are uploaded again at
+ *          'a', see the apps. Always upload with setTMS99XXfont, the table
+ *          starts at TMS99XX_ASCII_FIRST and may store 7 rows.
+ * 
  * @version 0.0.1
  * 
  * @TODO
@@ -35,141 +45,176 @@
 #ifndef __LIB_TMS99XX_ASCII
 #define __LIB_TMS99XX_ASCII
 
+#include <stdint.h>
 #include <tms99XXdatatypes.h>
 
+/** DEFINES **/
+/**
+ * @def TMS99XX_ASCII_FIRST
+ * first character in c_tms99XX_ascii, space.
+ */
+#define TMS99XX_ASCII_FIRST 32
+/**
+ * @def TMS99XX_ASCII_NUMBER
+ * characters in c_tms99XX_ascii, space to DEL.
+ */
+#define TMS99XX_ASCII_NUMBER 96
+
+#if defined(TMS99XX_ASCII_BIOS) && (defined(_COLECO) || defined(_COLECO_SGM))
+
+/**
+ * @def BIOS_FONT_ADDR
+ * OS 7 ASCII pattern table, the one LOAD_ASCII copies to vram.
+ */
+#ifndef BIOS_FONT_ADDR
+#define BIOS_FONT_ADDR 0x15A3
+#endif
+/**
+ * @def BIOS_FONT_FIRST
+ * first character in the BIOS table.
+ */
+#ifndef BIOS_FONT_FIRST
+#define BIOS_FONT_FIRST 0x1D
+#endif
+/**
+ * @def BIOS_FONT_NUMBER
+ * characters in the BIOS table, upper case only, ends with _.
+ */
+#ifndef BIOS_FONT_NUMBER
+#define BIOS_FONT_NUMBER 67
+#endif
+
+/**
+ * @def TMS99XX_ASCII_LOWER
+ * 1 when the font has lower case glyphs.
+ */
+#define TMS99XX_ASCII_LOWER 0
+
+/** BIOS character set, nothing added to the cart **/
+const struct s_tms99XX_font c_tms99XX_asciiFont = { (uint8_t const *)BIOS_FONT_ADDR, BIOS_FONT_FIRST, BIOS_FONT_NUMBER, 8 };
+
+#else
+
+#define TMS99XX_ASCII_LOWER 1
+
+/**
+ * @def TMS99XX_ASCII_ROWS
+ * rows stored per glyph.
+ */
+#ifdef TMS99XX_ASCII_7ROW
+#define TMS99XX_ASCII_ROWS 7
+#define TMS99XX_GLYPH(r0, r1, r2, r3, r4, r5, r6, r7) r0, r1, r2, r3, r4, r5, (r6 | r7)
+#else
+#define TMS99XX_ASCII_ROWS 8
+#define TMS99XX_GLYPH(r0, r1, r2, r3, r4, r5, r6, r7) r0, r1, r2, r3, r4, r5, r6, r7
+#endif
+
 /** From TMS9918 datasheet **/
 /** Fixed a few bugs, duplicate > and bad lower case letters **/
-/** Added nulls for first 32 to pad out struct, easier to just create strings and go. **/
-const union u_tms99XX_patternTable8x8 c_tms99XX_ascii[] = 
+/** Printable characters only, upload to pattern TMS99XX_ASCII_FIRST so strings map straight to names. **/
+const uint8_t c_tms99XX_ascii[] = 
 {
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // null
-  { .data = {0x20, 0x20, 0x20, 0x20, 0x20, 0x00, 0x20, 0x00}}, // !
-  { .data = {0x50, 0x50, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00}}, // "
-  { .data = {0x50, 0x50, 0xF8, 0x50, 0xF8, 0x50, 0x50, 0x00}}, // #
-  { .data = {0x20, 0x78, 0xA0, 0x70, 0x28, 0xF0, 0x20, 0x00}}, // $
-  { .data = {0xC0, 0xC8, 0x10, 0x20, 0x40, 0x98, 0x18, 0x00}}, // %
-  { .data = {0x40, 0xA0, 0xA0, 0x40, 0xA8, 0x90, 0x68, 0x00}}, // &
-  { .data = {0x20, 0x20, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00}}, // '
-  { .data = {0x20, 0x40, 0x80, 0x80, 0x80, 0x40, 0x20, 0x00}}, // (
-  { .data = {0x20, 0x10, 0x08, 0x08, 0x08, 0x10, 0x20, 0x00}}, // )
-  { .data = {0x20, 0xA8, 0x70, 0x20, 0x70, 0xA8, 0x20, 0x00}}, // *
-  { .data = {0x00, 0x20, 0x20, 0xF8, 0x20, 0x20, 0x00, 0x00}}, // +
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x20, 0x20, 0x40, 0x00}}, // ,
-  { .data = {0x00, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00}}, // -
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00}}, // .
-  { .data = {0x00, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00}}, // /
-  { .data = {0x70, 0x88, 0x98, 0xA8, 0xC8, 0x88, 0x70, 0x00}}, // 0
-  { .data = {0x20, 0x60, 0x20, 0x20, 0x20, 0x20, 0x70, 0x00}}, // 1
-  { .data = {0x70, 0x88, 0x08, 0x30, 0x40, 0x80, 0xF8, 0x00}}, // 2
-  { .data = {0xF8, 0x08, 0x10, 0x30, 0x08, 0x88, 0x70, 0x00}}, // 3
-  { .data = {0x10, 0x30, 0x50, 0x90, 0xF8, 0x10, 0x10, 0x00}}, // 4
-  { .data = {0xF8, 0x80, 0xF0, 0x08, 0x08, 0x88, 0x70, 0x00}}, // 5
-  { .data = {0x38, 0x40, 0x80, 0xF0, 0x88, 0x88, 0x70, 0x00}}, // 6
-  { .data = {0xF8, 0x08, 0x10, 0x20, 0x40, 0x40, 0x40, 0x00}}, // 7
-  { .data = {0x70, 0x88, 0x88, 0x70, 0x88, 0x88, 0x70, 0x00}}, // 8
-  { .data = {0x70, 0x88, 0x88, 0x78, 0x08, 0x10, 0xE0, 0x00}}, // 9
-  { .data = {0x00, 0x00, 0x20, 0x00, 0x20, 0x00, 0x00, 0x00}}, // :
-  { .data = {0x00, 0x00, 0x20, 0x00, 0x20, 0x20, 0x40, 0x00}}, // ;
-  { .data = {0x10, 0x20, 0x40, 0x80, 0x40, 0x20, 0x10, 0x00}}, // <
-  { .data = {0x00, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0x00, 0x00}}, // =
-  { .data = {0x40, 0x20, 0x10, 0x08, 0x10, 0x20, 0x40, 0x00}}, // >
-  { .data = {0x70, 0x88, 0x10, 0x20, 0x20, 0x00, 0x20, 0x00}}, // ?
-  { .data = {0x70, 0x88, 0xA8, 0xB8, 0x80, 0x80, 0x78, 0x00}}, // @
-  { .data = {0x20, 0x50, 0x88, 0x88, 0xF8, 0x88, 0x88, 0x00}}, // A
-  { .data = {0xF0, 0x88, 0x88, 0xF0, 0x88, 0x88, 0xF0, 0x00}}, // B
-  { .data = {0x70, 0x88, 0x80, 0x80, 0x80, 0x88, 0x70, 0x00}}, // C
-  { .data = {0xF0, 0x88, 0x88, 0x88, 0x88, 0x88, 0xF0, 0x00}}, // D
-  { .data = {0xF8, 0x80, 0x80, 0xF0, 0x80, 0x80, 0xF8, 0x00}}, // E
-  { .data = {0xF8, 0x80, 0x80, 0xF0, 0x80, 0x80, 0x80, 0x00}}, // F
-  { .data = {0x78, 0x80, 0x80, 0x80, 0x98, 0x88, 0x78, 0x00}}, // G
-  { .data = {0x88, 0x88, 0x88, 0xF8, 0x88, 0x88, 0x88, 0x00}}, // H
-  { .data = {0x70, 0x20, 0x20, 0x20, 0x20, 0x20, 0x70, 0x00}}, // I
-  { .data = {0x08, 0x08, 0x08, 0x08, 0x08, 0x88, 0x70, 0x00}}, // J
-  { .data = {0x88, 0x90, 0xA0, 0xC0, 0xA0, 0x90, 0x88, 0x00}}, // K
-  { .data = {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xF8, 0x00}}, // L
-  { .data = {0x88, 0xD8, 0xA8, 0xA8, 0x88, 0x88, 0x88, 0x00}}, // M
-  { .data = {0x88, 0x88, 0xC8, 0xA8, 0x98, 0x88, 0x88, 0x00}}, // N
-  { .data = {0x70, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00}}, // O
-  { .data = {0xF0, 0x88, 0x88, 0xF0, 0x80, 0x80, 0x80, 0x00}}, // P
-  { .data = {0x70, 0x88, 0x88, 0x88, 0xA8, 0x90, 0x68, 0x00}}, // Q
-  { .data = {0xF0, 0x88, 0x88, 0xF0, 0xA0, 0x90, 0x88, 0x00}}, // R
-  { .data = {0x70, 0x88, 0x80, 0x70, 0x08, 0x88, 0x70, 0x00}}, // S
-  { .data = {0xF8, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00}}, // T
-  { .data = {0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00}}, // U
-  { .data = {0x88, 0x88, 0x88, 0x88, 0x88, 0x50, 0x20, 0x00}}, // V
-  { .data = {0x88, 0x88, 0x88, 0xA8, 0xA8, 0xD8, 0x88, 0x00}}, // W
-  { .data = {0x88, 0x88, 0x50, 0x20, 0x50, 0x88, 0x88, 0x00}}, // X
-  { .data = {0x88, 0x88, 0x50, 0x20, 0x20, 0x20, 0x20, 0x00}}, // Y
-  { .data = {0xF8, 0x08, 0x10, 0x20, 0x40, 0x80, 0xF8, 0x00}}, // Z
-  { .data = {0xF8, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xF8, 0x00}}, // [
-  { .data = {0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x00, 0x00}}, // backslash
-  { .data = {0xF8, 0x18, 0x18, 0x18, 0x18, 0x18, 0xF8, 0x00}}, // ]
-  { .data = {0x00, 0x00, 0x20, 0x50, 0x88, 0x00, 0x00, 0x00}}, // ^
-  { .data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8}}, // _
-  { .data = {0x40, 0x20, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00}}, // `
-  { .data = {0x00, 0x00, 0x70, 0x88, 0xF8, 0x88, 0x88, 0x00}}, // a
-  { .data = {0x00, 0x00, 0xF0, 0x48, 0x70, 0x48, 0xF0, 0x00}}, // b
-  { .data = {0x00, 0x00, 0x78, 0x80, 0x80, 0x80, 0x78, 0x00}}, // c
-  { .data = {0x00, 0x00, 0xF0, 0x48, 0x48, 0x48, 0xF0, 0x00}}, // d
-  { .data = {0x00, 0x00, 0xF0, 0x80, 0xE0, 0x80, 0xF0, 0x00}}, // e
-  { .data = {0x00, 0x00, 0xF0, 0x80, 0xE0, 0x80, 0x80, 0x00}}, // f
-  { .data = {0x00, 0x00, 0x78, 0x80, 0xB8, 0x88, 0x70, 0x00}}, // g
-  { .data = {0x00, 0x00, 0x88, 0x88, 0xF8, 0x88, 0x88, 0x00}}, // h
-  { .data = {0x00, 0x00, 0xF8, 0x20, 0x20, 0x20, 0xF8, 0x00}}, // i
-  { .data = {0x00, 0x00, 0x70, 0x20, 0x20, 0xA0, 0xE0, 0x00}}, // j
-  { .data = {0x00, 0x00, 0x90, 0xA0, 0xC0, 0xA0, 0x90, 0x00}}, // k
-  { .data = {0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0xF8, 0x00}}, // l
-  { .data = {0x00, 0x00, 0x88, 0xD8, 0xA8, 0x88, 0x88, 0x00}}, // m
-  { .data = {0x00, 0x00, 0x88, 0xC8, 0xA8, 0x98, 0x88, 0x00}}, // n
-  { .data = {0x00, 0x00, 0xF8, 0x88, 0x88, 0x88, 0xF8, 0x00}}, // o
-  { .data = {0x00, 0x00, 0xF0, 0x88, 0xF0, 0x80, 0x80, 0x00}}, // p
-  { .data = {0x00, 0x00, 0xF8, 0x88, 0xA8, 0x90, 0xE8, 0x00}}, // q
-  { .data = {0x00, 0x00, 0xF8, 0x88, 0xF8, 0xA0, 0x90, 0x00}}, // r
-  { .data = {0x00, 0x00, 0x78, 0x80, 0x70, 0x08, 0xF0, 0x00}}, // s
-  { .data = {0x00, 0x00, 0xF8, 0x20, 0x20, 0x20, 0x20, 0x00}}, // t
-  { .data = {0x00, 0x00, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00}}, // u
-  { .data = {0x00, 0x00, 0x88, 0x88, 0x90, 0xA0, 0x40, 0x00}}, // v
-  { .data = {0x00, 0x00, 0x88, 0x88, 0xA8, 0xD8, 0x88, 0x00}}, // w
-  { .data = {0x00, 0x00, 0x88, 0x50, 0x20, 0x50, 0x88, 0x00}}, // x
-  { .data = {0x00, 0x00, 0x88, 0x50, 0x20, 0x20, 0x20, 0x00}}, // y
-  { .data = {0x00, 0x00, 0xF8, 0x10, 0x20, 0x40, 0xF8, 0x00}}, // z
-  { .data = {0x38, 0x40, 0x20, 0xC0, 0x20, 0x40, 0x38, 0x00}}, // {
-  { .data = {0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00}}, // |
-  { .data = {0xE0, 0x10, 0x20, 0x18, 0x20, 0x10, 0xE0, 0x00}}, // }
-  { .data = {0x40, 0xA8, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00}}, // ~
-  { .data = {0xA8, 0x50, 0xA8, 0x50, 0xA8, 0x50, 0xA8, 0x00}}  // DEL
+  TMS99XX_GLYPH(0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00), // space
+  TMS99XX_GLYPH(0x20, 0x20, 0x20, 0x20, 0x20, 0x00, 0x20, 0x00), // !
+  TMS99XX_GLYPH(0x50, 0x50, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00), // "
+  TMS99XX_GLYPH(0x50, 0x50, 0xF8, 0x50, 0xF8, 0x50, 0x50, 0x00), // #
+  TMS99XX_GLYPH(0x20, 0x78, 0xA0, 0x70, 0x28, 0xF0, 0x20, 0x00), // $
+  TMS99XX_GLYPH(0xC0, 0xC8, 0x10, 0x20, 0x40, 0x98, 0x18, 0x00), // %
+  TMS99XX_GLYPH(0x40, 0xA0, 0xA0, 0x40, 0xA8, 0x90, 0x68, 0x00), // &
+  TMS99XX_GLYPH(0x20, 0x20, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00), // '
+  TMS99XX_GLYPH(0x20, 0x40, 0x80, 0x80, 0x80, 0x40, 0x20, 0x00), // (
+  TMS99XX_GLYPH(0x20, 0x10, 0x08, 0x08, 0x08, 0x10, 0x20, 0x00), // )
+  TMS99XX_GLYPH(0x20, 0xA8, 0x70, 0x20, 0x70, 0xA8, 0x20, 0x00), // *
+  TMS99XX_GLYPH(0x00, 0x20, 0x20, 0xF8, 0x20, 0x20, 0x00, 0x00), // +
+  TMS99XX_GLYPH(0x00, 0x00, 0x00, 0x00, 0x20, 0x20, 0x40, 0x00), // ,
+  TMS99XX_GLYPH(0x00, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00), // -
+  TMS99XX_GLYPH(0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00), // .
+  TMS99XX_GLYPH(0x00, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00), // /
+  TMS99XX_GLYPH(0x70, 0x88, 0x98, 0xA8, 0xC8, 0x88, 0x70, 0x00), // 0
+  TMS99XX_GLYPH(0x20, 0x60, 0x20, 0x20, 0x20, 0x20, 0x70, 0x00), // 1
+  TMS99XX_GLYPH(0x70, 0x88, 0x08, 0x30, 0x40, 0x80, 0xF8, 0x00), // 2
+  TMS99XX_GLYPH(0xF8, 0x08, 0x10, 0x30, 0x08, 0x88, 0x70, 0x00), // 3
+  TMS99XX_GLYPH(0x10, 0x30, 0x50, 0x90, 0xF8, 0x10, 0x10, 0x00), // 4
+  TMS99XX_GLYPH(0xF8, 0x80, 0xF0, 0x08, 0x08, 0x88, 0x70, 0x00), // 5
+  TMS99XX_GLYPH(0x38, 0x40, 0x80, 0xF0, 0x88, 0x88, 0x70, 0x00), // 6
+  TMS99XX_GLYPH(0xF8, 0x08, 0x10, 0x20, 0x40, 0x40, 0x40, 0x00), // 7
+  TMS99XX_GLYPH(0x70, 0x88, 0x88, 0x70, 0x88, 0x88, 0x70, 0x00), // 8
+  TMS99XX_GLYPH(0x70, 0x88, 0x88, 0x78, 0x08, 0x10, 0xE0, 0x00), // 9
+  TMS99XX_GLYPH(0x00, 0x00, 0x20, 0x00, 0x20, 0x00, 0x00, 0x00), // :
+  TMS99XX_GLYPH(0x00, 0x00, 0x20, 0x00, 0x20, 0x20, 0x40, 0x00), // ;
+  TMS99XX_GLYPH(0x10, 0x20, 0x40, 0x80, 0x40, 0x20, 0x10, 0x00), // <
+  TMS99XX_GLYPH(0x00, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0x00, 0x00), // =
+  TMS99XX_GLYPH(0x40, 0x20, 0x10, 0x08, 0x10, 0x20, 0x40, 0x00), // >
+  TMS99XX_GLYPH(0x70, 0x88, 0x10, 0x20, 0x20, 0x00, 0x20, 0x00), // ?
+  TMS99XX_GLYPH(0x70, 0x88, 0xA8, 0xB8, 0x80, 0x80, 0x78, 0x00), // @
+  TMS99XX_GLYPH(0x20, 0x50, 0x88, 0x88, 0xF8, 0x88, 0x88, 0x00), // A
+  TMS99XX_GLYPH(0xF0, 0x88, 0x88, 0xF0, 0x88, 0x88, 0xF0, 0x00), // B
+  TMS99XX_GLYPH(0x70, 0x88, 0x80, 0x80, 0x80, 0x88, 0x70, 0x00), // C
+  TMS99XX_GLYPH(0xF0, 0x88, 0x88, 0x88, 0x88, 0x88, 0xF0, 0x00), // D
+  TMS99XX_GLYPH(0xF8, 0x80, 0x80, 0xF0, 0x80, 0x80, 0xF8, 0x00), // E
+  TMS99XX_GLYPH(0xF8, 0x80, 0x80, 0xF0, 0x80, 0x80, 0x80, 0x00), // F
+  TMS99XX_GLYPH(0x78, 0x80, 0x80, 0x80, 0x98, 0x88, 0x78, 0x00), // G
+  TMS99XX_GLYPH(0x88, 0x88, 0x88, 0xF8, 0x88, 0x88, 0x88, 0x00), // H
+  TMS99XX_GLYPH(0x70, 0x20, 0x20, 0x20, 0x20, 0x20, 0x70, 0x00), // I
+  TMS99XX_GLYPH(0x08, 0x08, 0x08, 0x08, 0x08, 0x88, 0x70, 0x00), // J
+  TMS99XX_GLYPH(0x88, 0x90, 0xA0, 0xC0, 0xA0, 0x90, 0x88, 0x00), // K
+  TMS99XX_GLYPH(0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xF8, 0x00), // L
+  TMS99XX_GLYPH(0x88, 0xD8, 0xA8, 0xA8, 0x88, 0x88, 0x88, 0x00), // M
+  TMS99XX_GLYPH(0x88, 0x88, 0xC8, 0xA8, 0x98, 0x88, 0x88, 0x00), // N
+  TMS99XX_GLYPH(0x70, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00), // O
+  TMS99XX_GLYPH(0xF0, 0x88, 0x88, 0xF0, 0x80, 0x80, 0x80, 0x00), // P
+  TMS99XX_GLYPH(0x70, 0x88, 0x88, 0x88, 0xA8, 0x90, 0x68, 0x00), // Q
+  TMS99XX_GLYPH(0xF0, 0x88, 0x88, 0xF0, 0xA0, 0x90, 0x88, 0x00), // R
+  TMS99XX_GLYPH(0x70, 0x88, 0x80, 0x70, 0x08, 0x88, 0x70, 0x00), // S
+  TMS99XX_GLYPH(0xF8, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00), // T
+  TMS99XX_GLYPH(0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00), // U
+  TMS99XX_GLYPH(0x88, 0x88, 0x88, 0x88, 0x88, 0x50, 0x20, 0x00), // V
+  TMS99XX_GLYPH(0x88, 0x88, 0x88, 0xA8, 0xA8, 0xD8, 0x88, 0x00), // W
+  TMS99XX_GLYPH(0x88, 0x88, 0x50, 0x20, 0x50, 0x88, 0x88, 0x00), // X
+  TMS99XX_GLYPH(0x88, 0x88, 0x50, 0x20, 0x20, 0x20, 0x20, 0x00), // Y
+  TMS99XX_GLYPH(0xF8, 0x08, 0x10, 0x20, 0x40, 0x80, 0xF8, 0x00), // Z
+  TMS99XX_GLYPH(0xF8, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xF8, 0x00), // [
+  TMS99XX_GLYPH(0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x00, 0x00), // backslash
+  TMS99XX_GLYPH(0xF8, 0x18, 0x18, 0x18, 0x18, 0x18, 0xF8, 0x00), // ]
+  TMS99XX_GLYPH(0x00, 0x00, 0x20, 0x50, 0x88, 0x00, 0x00, 0x00), // ^
+  TMS99XX_GLYPH(0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8), // _
+  TMS99XX_GLYPH(0x40, 0x20, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00), // `
+  TMS99XX_GLYPH(0x00, 0x00, 0x70, 0x88, 0xF8, 0x88, 0x88, 0x00), // a
+  TMS99XX_GLYPH(0x00, 0x00, 0xF0, 0x48, 0x70, 0x48, 0xF0, 0x00), // b
+  TMS99XX_GLYPH(0x00, 0x00, 0x78, 0x80, 0x80, 0x80, 0x78, 0x00), // c
+  TMS99XX_GLYPH(0x00, 0x00, 0xF0, 0x48, 0x48, 0x48, 0xF0, 0x00), // d
+  TMS99XX_GLYPH(0x00, 0x00, 0xF0, 0x80, 0xE0, 0x80, 0xF0, 0x00), // e
+  TMS99XX_GLYPH(0x00, 0x00, 0xF0, 0x80, 0xE0, 0x80, 0x80, 0x00), // f
+  TMS99XX_GLYPH(0x00, 0x00, 0x78, 0x80, 0xB8, 0x88, 0x70, 0x00), // g
+  TMS99XX_GLYPH(0x00, 0x00, 0x88, 0x88, 0xF8, 0x88, 0x88, 0x00), // h
+  TMS99XX_GLYPH(0x00, 0x00, 0xF8, 0x20, 0x20, 0x20, 0xF8, 0x00), // i
+  TMS99XX_GLYPH(0x00, 0x00, 0x70, 0x20, 0x20, 0xA0, 0xE0, 0x00), // j
+  TMS99XX_GLYPH(0x00, 0x00, 0x90, 0xA0, 0xC0, 0xA0, 0x90, 0x00), // k
+  TMS99XX_GLYPH(0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0xF8, 0x00), // l
+  TMS99XX_GLYPH(0x00, 0x00, 0x88, 0xD8, 0xA8, 0x88, 0x88, 0x00), // m
+  TMS99XX_GLYPH(0x00, 0x00, 0x88, 0xC8, 0xA8, 0x98, 0x88, 0x00), // n
+  TMS99XX_GLYPH(0x00, 0x00, 0xF8, 0x88, 0x88, 0x88, 0xF8, 0x00), // o
+  TMS99XX_GLYPH(0x00, 0x00, 0xF0, 0x88, 0xF0, 0x80, 0x80, 0x00), // p
+  TMS99XX_GLYPH(0x00, 0x00, 0xF8, 0x88, 0xA8, 0x90, 0xE8, 0x00), // q
+  TMS99XX_GLYPH(0x00, 0x00, 0xF8, 0x88, 0xF8, 0xA0, 0x90, 0x00), // r
+  TMS99XX_GLYPH(0x00, 0x00, 0x78, 0x80, 0x70, 0x08, 0xF0, 0x00), // s
+  TMS99XX_GLYPH(0x00, 0x00, 0xF8, 0x20, 0x20, 0x20, 0x20, 0x00), // t
+  TMS99XX_GLYPH(0x00, 0x00, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00), // u
+  TMS99XX_GLYPH(0x00, 0x00, 0x88, 0x88, 0x90, 0xA0, 0x40, 0x00), // v
+  TMS99XX_GLYPH(0x00, 0x00, 0x88, 0x88, 0xA8, 0xD8, 0x88, 0x00), // w
+  TMS99XX_GLYPH(0x00, 0x00, 0x88, 0x50, 0x20, 0x50, 0x88, 0x00), // x
+  TMS99XX_GLYPH(0x00, 0x00, 0x88, 0x50, 0x20, 0x20, 0x20, 0x00), // y
+  TMS99XX_GLYPH(0x00, 0x00, 0xF8, 0x10, 0x20, 0x40, 0xF8, 0x00), // z
+  TMS99XX_GLYPH(0x38, 0x40, 0x20, 0xC0, 0x20, 0x40, 0x38, 0x00), // {
+  TMS99XX_GLYPH(0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00), // |
+  TMS99XX_GLYPH(0xE0, 0x10, 0x20, 0x18, 0x20, 0x10, 0xE0, 0x00), // }
+  TMS99XX_GLYPH(0x40, 0xA8, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00), // ~
+  TMS99XX_GLYPH(0xA8, 0x50, 0xA8, 0x50, 0xA8, 0x50, 0xA8, 0x00)   // DEL
 };
 
+/** font description for setTMS99XXfont **/
+const struct s_tms99XX_font c_tms99XX_asciiFont = { c_tms99XX_ascii, TMS99XX_ASCII_FIRST, TMS99XX_ASCII_NUMBER, TMS99XX_ASCII_ROWS };
+
+#endif
+
 #endif
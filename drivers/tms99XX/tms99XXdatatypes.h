@@ -87,6 +87,130 @@ struct s_tms99XX
    * color sent to register 7, background/text color.
    */
   uint8_t colorReg;
+  /**
+   * @var s_tms99XX::bootFrames
+   * frames counted from init till the first unblank, boot latency.
+   */
+  uint16_t bootFrames;
+  /**
+   * @var s_tms99XX::bootCount
+   * frameCount when bootFrames was last brought up to date.
+   */
+  uint8_t bootCount;
+  /**
+   * @var s_tms99XX::bootTiming
+   * 1 while boot frames are counted, cleared on first unblank.
+   */
+  uint8_t bootTiming;
+};
+
+/**
+ * @struct s_tms99XX_vramTest
+ * @brief Struct for the first failure found by a VRAM test.
+ */
+struct s_tms99XX_vramTest
+{
+  /**
+   * @var s_tms99XX_vramTest::address
+   * VRAM address that failed.
+   */
+  uint16_t address;
+  /**
+   * @var s_tms99XX_vramTest::expected
+   * data written to the address.
+   */
+  uint8_t expected;
+  /**
+   * @var s_tms99XX_vramTest::actual
+   * data read back from the address.
+   */
+  uint8_t actual;
+  /**
+   * @var s_tms99XX_vramTest::bits
+   * failing bits, expected xor actual.
+   */
+  uint8_t bits;
+  /**
+   * @var s_tms99XX_vramTest::stage
+   * test stage that failed, see VRAM_STAGE defines.
+   */
+  uint8_t stage;
+};
+
+/**
+ * @struct s_tms99XX_snapshot
+ * @brief Struct for a saved name table region, patterns and colors in GFX II.
+ */
+struct s_tms99XX_snapshot
+{
+  /**
+   * @var s_tms99XX_snapshot::p_buffer
+   * RAM store for the region, 0 when stored in spare VRAM.
+   */
+  uint8_t *p_buffer;
+  /**
+   * @var s_tms99XX_snapshot::vramAddr
+   * spare VRAM store address, used when p_buffer is 0.
+   */
+  uint16_t vramAddr;
+  /**
+   * @var s_tms99XX_snapshot::size
+   * bytes in the store, names then patterns then colors.
+   */
+  uint16_t size;
+  /**
+   * @var s_tms99XX_snapshot::index
+   * transfer position in the store.
+   */
+  uint16_t index;
+  /**
+   * @var s_tms99XX_snapshot::x
+   * first name table column.
+   */
+  uint8_t x;
+  /**
+   * @var s_tms99XX_snapshot::y
+   * first name table row.
+   */
+  uint8_t y;
+  /**
+   * @var s_tms99XX_snapshot::width
+   * columns in the region.
+   */
+  uint8_t width;
+  /**
+   * @var s_tms99XX_snapshot::height
+   * rows in the region.
+   */
+  uint8_t height;
+};
+
+/**
+ * @struct s_tms99XX_font
+ * @brief Struct describing a glyph set in ROM for setTMS99XXfont.
+ */
+struct s_tms99XX_font
+{
+  /**
+   * @var s_tms99XX_font::p_data
+   * glyph rows, rows bytes per glyph.
+   */
+  uint8_t const *p_data;
+  /**
+   * @var s_tms99XX_font::first
+   * character code of the first glyph.
+   */
+  uint8_t first;
+  /**
+   * @var s_tms99XX_font::number
+   * glyphs in the set.
+   */
+  uint8_t number;
+  /**
+   * @var s_tms99XX_font::rows
+   * rows stored per glyph, 1 to 8, missing bottom rows upload as 0.
+   */
+  uint8_t rows;
 };
 
 /**
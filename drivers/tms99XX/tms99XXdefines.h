@@ -85,6 +85,13 @@
  */
 #define SPRITE_MAG_BIT 0
 
+/** status register bit defines **/
+/**
+ * @def FRAME_FLAG_BIT
+ * frame flag, set at the end of each active display (vblank).
+ */
+#define FRAME_FLAG_BIT 7
+
 /** REGISTER DEFINES **/
 /**
  * @def REGISTER_0
@@ -190,6 +197,63 @@
  */
 #define SPRITE_PATTERN_TABLE_ADDR_SCALE 11
 
+/** TABLE SIZE DEFINES **/
+/**
+ * @def NAME_TABLE_SIZE
+ * name table size for graphics I, II, and bitmap (32x24)
+ */
+#define NAME_TABLE_SIZE 768
+/**
+ * @def NAME_TABLE_TXT_SIZE
+ * name table size for text mode (40x24)
+ */
+#define NAME_TABLE_TXT_SIZE 960
+/**
+ * @def NAME_TABLE_COLS
+ * name table columns for graphics I, II, and bitmap
+ */
+#define NAME_TABLE_COLS 32
+/**
+ * @def NAME_TABLE_TXT_COLS
+ * name table columns for text mode
+ */
+#define NAME_TABLE_TXT_COLS 40
+/**
+ * @def NAME_TABLE_ROWS
+ * name table rows for all modes
+ */
+#define NAME_TABLE_ROWS 24
+/**
+ * @def PATTERN_TABLE_SIZE
+ * pattern table size for graphics I and text (256 patterns of 8 bytes)
+ */
+#define PATTERN_TABLE_SIZE 2048
+/**
+ * @def PATTERN_TABLE_GFXII_SIZE
+ * pattern table size for graphics II (3 banks of 256 patterns)
+ */
+#define PATTERN_TABLE_GFXII_SIZE 6144
+/**
+ * @def PATTERN_TABLE_BMP_SIZE
+ * pattern table size for bitmap (multicolor), 192 pixel blocks of 8 bytes
+ */
+#define PATTERN_TABLE_BMP_SIZE 1536
+/**
+ * @def COLOR_TABLE_SIZE
+ * color table size for graphics I (one byte per 8 patterns)
+ */
+#define COLOR_TABLE_SIZE 32
+/**
+ * @def COLOR_TABLE_GFXII_SIZE
+ * color table size for graphics II (one byte per pattern row)
+ */
+#define COLOR_TABLE_GFXII_SIZE 6144
+/**
+ * @def SPRITE_ATTRIBUTE_TABLE_SIZE
+ * sprite attribute table size (32 sprites of 4 bytes)
+ */
+#define SPRITE_ATTRIBUTE_TABLE_SIZE 128
+
 /** COLOR DEFINES **/
 /**
  * @def TMS_TRANSPARENT
@@ -285,4 +349,92 @@
  */
 #define SPRITE_TERM 0xD0
 
+/** VRAM TEST DEFINES **/
+/**
+ * @def VRAM_TEST_QUICK
+ * address in address test and a short march (w0, r0w1, r1w0 down, r0).
+ */
+#define VRAM_TEST_QUICK 0
+/**
+ * @def VRAM_TEST_FULL
+ * address in address, March C- with 0x00/0xFF and 0x55/0xAA, walking 1 and 0.
+ */
+#define VRAM_TEST_FULL 1
+/**
+ * @def VRAM_STAGE_ADDRESS
+ * failure found by the address in address test, address line fault.
+ */
+#define VRAM_STAGE_ADDRESS 1
+/**
+ * @def VRAM_STAGE_MARCH
+ * failure found by a march element, stuck or coupled bits.
+ */
+#define VRAM_STAGE_MARCH 2
+/**
+ * @def VRAM_STAGE_WALK
+ * failure found by the walking bit test, stuck or shorted data lines.
+ */
+#define VRAM_STAGE_WALK 3
+
+/** SNAPSHOT DEFINES **/
+/**
+ * @def SNAPSHOT_VBLANK_US
+ * NTSC vblank, 70 lines of 63.5 us, PAL has more.
+ */
+#define SNAPSHOT_VBLANK_US 4445
+/**
+ * @def SNAPSHOT_SPARE_US
+ * vblank left for the irq entry and the rest of the callback.
+ */
+#define SNAPSHOT_SPARE_US 1000
+/**
+ * @def SNAPSHOT_BYTE_T
+ * T-states a byte in the unrolled port loops.
+ */
+#define SNAPSHOT_BYTE_T 16
+/**
+ * @def SNAPSHOT_SEGMENT_T
+ * T-states to set up one segment, call and vram address.
+ */
+#define SNAPSHOT_SEGMENT_T 200
+/**
+ * @def SNAPSHOT_VBLANK_T
+ * T-states a snapshot move can take inside the vblank.
+ */
+#define SNAPSHOT_VBLANK_T US_TO_TSTATES(SNAPSHOT_VBLANK_US - SNAPSHOT_SPARE_US)
+/**
+ * @def SNAPSHOT_VBLANK_BYTES
+ * bytes of one segment that fit SNAPSHOT_VBLANK_T, a guide. The check counts
+ * every segment setup, spare VRAM stores count twice. Larger moves blank
+ * the display.
+ */
+#define SNAPSHOT_VBLANK_BYTES ((SNAPSHOT_VBLANK_T - SNAPSHOT_SEGMENT_T) / SNAPSHOT_BYTE_T)
+
+/** FONT STYLE DEFINES **/
+/**
+ * @def FONT_PLAIN
+ * glyphs uploaded as stored.
+ */
+#define FONT_PLAIN 0x00
+/**
+ * @def FONT_INVERT
+ * glyph bits inverted, applied last.
+ */
+#define FONT_INVERT 0x01
+/**
+ * @def FONT_BOLD
+ * each row or'd with itself shifted right one pixel.
+ */
+#define FONT_BOLD 0x02
+/**
+ * @def FONT_SHADOW
+ * each row or'd with the row above shifted right, drop shadow down and right.
+ */
+#define FONT_SHADOW 0x04
+/**
+ * @def FONT_UNDERLINE
+ * last row of each glyph set.
+ */
+#define FONT_UNDERLINE 0x08
+
 #endif
@@ -0,0 +1,258 @@
+/*******************************************************************************
+ * @file    tms99XXfx.h
+ * @brief   Color effects for TI TMS9918/28/29 video display processor library.
+ * @author  Jay Convertino(electrobs@gmail.com)
+ * @date    2026.10.19
+ * @details Fades, color cycling, and flashes on the graphics I color table and
+ *          the register 7 backdrop/text color. Effects only change a RAM copy
+ *          and mark entries dirty, tickTMS99XXfx is called once a frame from
+ *          the vdp irq callback and writes at most FX_MAX_WRITES entries.
+ *          The driver colorReg stays the unfaded backdrop, each effect start
+ *          takes the backdrop from it.
+ *
+ * @version 0.0.1
+ *
+ * @license mit
+ *
+ * Copyright 2026 Johnathan Convertino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef __LIB_TMS99XX_FX
+#define __LIB_TMS99XX_FX
+
+#include <stdint.h>
+#include <tms99XX.h>
+
+/** DEFINES **/
+/**
+ * @def FX_BACKDROP
+ * entry number for register 7, backdrop and text color. Entries 0 to 31 are
+ * the graphics I color table.
+ */
+#define FX_BACKDROP COLOR_TABLE_SIZE
+/**
+ * @def FX_ENTRIES
+ * number of entries, color table plus register 7.
+ */
+#define FX_ENTRIES (COLOR_TABLE_SIZE + 1)
+/**
+ * @def FX_FADE_STEPS
+ * steps in each fade ramp, 0 is full color, FX_FADE_STEPS-1 is black.
+ */
+#define FX_FADE_STEPS 4
+/**
+ * @def FX_MAX_WRITES
+ * most entries written per tick, each is at most 3 port writes.
+ */
+#ifndef FX_MAX_WRITES
+#define FX_MAX_WRITES 8
+#endif
+/**
+ * @def FX_FADE_NONE
+ * no fade running.
+ */
+#define FX_FADE_NONE 0
+/**
+ * @def FX_FADE_OUT
+ * fade from full color to black.
+ */
+#define FX_FADE_OUT 1
+/**
+ * @def FX_FADE_IN
+ * fade from black to full color.
+ */
+#define FX_FADE_IN 2
+
+/** FADE RAMPS **/
+/**
+ * @var c_tms99XX_fadeRamp
+ * FX_FADE_STEPS colors for each of the 16 TMS colors, index color * FX_FADE_STEPS + step.
+ */
+extern const uint8_t c_tms99XX_fadeRamp[];
+
+/** DATA STRUCTURES **/
+/**
+ * @struct s_tms99XXfx
+ * @brief Struct for containing color effect state.
+ */
+struct s_tms99XXfx
+{
+  /**
+   * @var s_tms99XXfx::p_tms99XX
+   * vdp the effects are written to.
+   */
+  struct s_tms99XX *p_tms99XX;
+  /**
+   * @var s_tms99XXfx::base
+   * color table and register 7 as set by the application, unfaded.
+   */
+  uint8_t base[FX_ENTRIES];
+  /**
+   * @var s_tms99XXfx::dirty
+   * one bit per entry that needs to be written.
+   */
+  uint8_t dirty[(FX_ENTRIES + 7) >> 3];
+  /**
+   * @var s_tms99XXfx::scan
+   * next entry to check for a write, spreads writes over frames.
+   */
+  uint8_t scan;
+  /**
+   * @var s_tms99XXfx::fadeDir
+   * FX_FADE_NONE, FX_FADE_OUT, or FX_FADE_IN.
+   */
+  uint8_t fadeDir;
+  /**
+   * @var s_tms99XXfx::fadeStep
+   * current step into the fade ramps.
+   */
+  uint8_t fadeStep;
+  /**
+   * @var s_tms99XXfx::fadeRate
+   * frames per fade step.
+   */
+  uint8_t fadeRate;
+  /**
+   * @var s_tms99XXfx::fadeCount
+   * frames since last fade step.
+   */
+  uint8_t fadeCount;
+  /**
+   * @var s_tms99XXfx::cycleStart
+   * first entry to cycle.
+   */
+  uint8_t cycleStart;
+  /**
+   * @var s_tms99XXfx::cycleLen
+   * number of entries to cycle.
+   */
+  uint8_t cycleLen;
+  /**
+   * @var s_tms99XXfx::cycleRate
+   * frames per cycle step, 0 is off.
+   */
+  uint8_t cycleRate;
+  /**
+   * @var s_tms99XXfx::cycleCount
+   * frames since last cycle step.
+   */
+  uint8_t cycleCount;
+  /**
+   * @var s_tms99XXfx::flashEntry
+   * entry to flash.
+   */
+  uint8_t flashEntry;
+  /**
+   * @var s_tms99XXfx::flashColor
+   * color byte shown while the flash is on.
+   */
+  uint8_t flashColor;
+  /**
+   * @var s_tms99XXfx::flashRate
+   * frames per flash toggle.
+   */
+  uint8_t flashRate;
+  /**
+   * @var s_tms99XXfx::flashCount
+   * flashes left, 0 is off.
+   */
+  uint8_t flashCount;
+  /**
+   * @var s_tms99XXfx::flashTimer
+   * frames since last toggle.
+   */
+  uint8_t flashTimer;
+  /**
+   * @var s_tms99XXfx::flashState
+   * 1 while the flash color is shown.
+   */
+  uint8_t flashState;
+};
+
+/** METHODS **/
+
+/***************************************************************************//**
+ * @brief   Initialize color effects for a vdp. Nothing is written to the vdp.
+ *
+ * @param   p_fx pointer to struct to contain effect data.
+ * @param   p_tms99XX pointer to the vdp struct, must stay valid.
+ * @param   p_colorTable 32 byte graphics I color table already in vram, 0 for
+ *          all entries 0.
+ ******************************************************************************/
+void initTMS99XXfx(struct s_tms99XXfx * const p_fx, struct s_tms99XX * const p_tms99XX, uint8_t const * const p_colorTable);
+
+/***************************************************************************//**
+ * @brief   Set an entry color, queued for the next tick.
+ *
+ * @param   p_fx pointer to struct to contain effect data.
+ * @param   entry 0 to 31 color table, FX_BACKDROP for register 7.
+ * @param   color color byte, foreground upper nibble, background lower.
+ ******************************************************************************/
+void setTMS99XXfxColor(struct s_tms99XXfx * const p_fx, uint8_t entry, uint8_t color);
+
+/***************************************************************************//**
+ * @brief   Start a fade of all entries.
+ *
+ * @param   p_fx pointer to struct to contain effect data.
+ * @param   direction FX_FADE_OUT or FX_FADE_IN.
+ * @param   rate frames per fade step.
+ ******************************************************************************/
+void setTMS99XXfxFade(struct s_tms99XXfx * const p_fx, uint8_t direction, uint8_t rate);
+
+/***************************************************************************//**
+ * @brief   Rotate a range of entries by one entry every rate frames.
+ *
+ * @param   p_fx pointer to struct to contain effect data.
+ * @param   start first entry to cycle.
+ * @param   len number of entries in the cycle.
+ * @param   rate frames per step, 0 stops cycling.
+ ******************************************************************************/
+void setTMS99XXfxCycle(struct s_tms99XXfx * const p_fx, uint8_t start, uint8_t len, uint8_t rate);
+
+/***************************************************************************//**
+ * @brief   Flash an entry to a color and back.
+ *
+ * @param   p_fx pointer to struct to contain effect data.
+ * @param   entry 0 to 31 color table, FX_BACKDROP for register 7.
+ * @param   color color byte shown while on.
+ * @param   rate frames per toggle.
+ * @param   count number of flashes, 0 stops flashing.
+ ******************************************************************************/
+void setTMS99XXfxFlash(struct s_tms99XXfx * const p_fx, uint8_t entry, uint8_t color, uint8_t rate, uint8_t count);
+
+/***************************************************************************//**
+ * @brief   Check if any effect is still running or writes are queued.
+ *
+ * @param   p_fx pointer to struct to contain effect data.
+ * @return  0 when idle, 1 when busy.
+ ******************************************************************************/
+uint8_t getTMS99XXfxBusy(struct s_tms99XXfx * const p_fx);
+
+/***************************************************************************//**
+ * @brief   Step all effects one frame and write queued entries. Call once per
+ *          frame from the vdp irq callback, main code must not be in the middle
+ *          of a vram access when it runs.
+ *
+ * @param   p_fx pointer to struct to contain effect data.
+ ******************************************************************************/
+void tickTMS99XXfx(struct s_tms99XXfx * const p_fx);
+
+#endif